@@ -0,0 +1,64 @@
+#ifndef ATLAS_H
+#define ATLAS_H
+
+#include "graphic.h"
+#include <unordered_map>
+
+#define ATLAS_WIDTH 1024 // width of the atlas surfaces in pixels
+
+/**
+ * @brief The atlas keeps the sprites already scaled to their size in the
+ * window, in the pixel format of the window, so that a frame is drawn with
+ * plain blits.
+ *
+ * @note The sprites drawn with a colour key are in a surface whose colour key
+ * and RLE acceleration are set once, the others in an opaque surface. The
+ * sprites are placed on shelves, line after line.
+ */
+class spriteAtlas {
+  public:
+    spriteAtlas();
+    spriteAtlas(const spriteAtlas &) = delete;
+    spriteAtlas &operator=(const spriteAtlas &) = delete;
+    /**
+     * @brief Scale the sprites of a list in the atlas.
+     *
+     * @param spriteBoard the sprite sheet
+     * @param format the pixel format of the window
+     * @param sprites the sprites with their size, as given by listSprites
+     * @return true
+     * @return false if a surface can not be created
+     */
+    bool build(SDL_Surface *spriteBoard, const SDL_PixelFormat *format,
+               const std::vector<DrawCommand> &sprites);
+    /**
+     * @brief Free the surfaces of the atlas.
+     */
+    void clear();
+    /**
+     * @brief Find the scaled sprite of a drawing.
+     *
+     * @param command
+     * @param surface the surface of the atlas where the sprite is
+     * @return const SDL_Rect* the area of the sprite in the surface, nullptr
+     * if the sprite is not in the atlas at this size
+     */
+    const SDL_Rect *find(const DrawCommand &command,
+                         SDL_Surface **surface) const;
+
+  private:
+    /**
+     * @brief Get the key of a sprite: its area in the sheet, its size in the
+     * window and its colour key.
+     *
+     * @param command
+     * @return uint64_t
+     */
+    static uint64_t key(const DrawCommand &command);
+
+    // opaque sprites and sprites with colour key
+    SDL_Surface *_opaque, *_keyed;
+    std::unordered_map<uint64_t, SDL_Rect> _rects;
+};
+
+#endif
@@ -0,0 +1,177 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include "grid.h"
+
+#define DIR_MASK(d) (1u << (d)) // bit of a direction in a mask of moves
+
+/**
+ * @brief Get a direction of a mask of moves, in the order of the enum.
+ *
+ * @param moves DIR_MASK of each direction
+ * @param n index of the direction among the ones of the mask, less than
+ * their number
+ * @return dir
+ */
+inline dir nthDir(unsigned moves, unsigned n) {
+    for (; n > 0; n--)
+        moves &= moves - 1;
+    return dir(__builtin_ctz(moves));
+}
+
+enum layer {
+    LAYER_HALL,
+    LAYER_WALL,
+    LAYER_DOOR,
+    LAYER_DOT,
+    LAYER_POWERUP,
+    LAYER_PACMAN,
+    LAYER_GHOST,
+    NB_LAYERS
+};
+
+/**
+ * @brief One bit per square of the board for each layer (walls, items,
+ * actors).
+ *
+ * @note Each line of a layer is stored in a few 64-bit words and the lines of
+ * a layer are contiguous, so that a layer is counted or combined with another
+ * one word by word instead of reading each square. A position outside the
+ * board is never set.
+ */
+class bitboard {
+  public:
+    bitboard();
+    ~bitboard();
+    /**
+     * @brief Fill the layers with the states and the items of the squares,
+     * the actor layers are empty.
+     *
+     * @param vecBoard
+     */
+    void build(gridView vecBoard);
+    /**
+     * @brief Check if the layers are built.
+     *
+     * @return true
+     * @return false
+     */
+    bool isBuilt() const { return !_words.empty(); }
+    /**
+     * @brief Get the number of 64-bit words of a line.
+     *
+     * @return size_t
+     */
+    size_t getRowWords() const { return _rowWords; }
+    /**
+     * @brief Get the words of a line of a layer.
+     *
+     * @param l
+     * @param y
+     * @return const uint64_t*
+     */
+    const uint64_t *getRow(layer l, size_t y) const {
+        return &_words[(l * _height + y) * _rowWords];
+    }
+    /**
+     * @brief Check if the bit of a square is set.
+     *
+     * @param l
+     * @param x
+     * @param y
+     * @return true
+     * @return false outside the board
+     */
+    bool test(layer l, size_t x, size_t y) const {
+        if (x >= _width || y >= _height)
+            return false;
+        return (getRow(l, y)[x / 64] >> (x % 64)) & 1;
+    }
+    /**
+     * @brief Set the bit of a square.
+     *
+     * @param l
+     * @param x
+     * @param y
+     */
+    void set(layer l, size_t x, size_t y) {
+        _words[(l * _height + y) * _rowWords + x / 64] |= uint64_t(1)
+                                                           << (x % 64);
+    }
+    /**
+     * @brief Clear the bit of a square.
+     *
+     * @param l
+     * @param x
+     * @param y
+     */
+    void reset(layer l, size_t x, size_t y) {
+        _words[(l * _height + y) * _rowWords + x / 64] &=
+            ~(uint64_t(1) << (x % 64));
+    }
+    /**
+     * @brief Clear all the bits of a layer.
+     *
+     * @param l
+     */
+    void clear(layer l);
+    /**
+     * @brief Get the number of squares set in a layer.
+     *
+     * @param l
+     * @return size_t
+     */
+    size_t count(layer l) const;
+    /**
+     * @brief Get the number of squares set in a layer at a distance of at
+     * most radius squares from a square (without the tunnel).
+     *
+     * @param l
+     * @param x
+     * @param y
+     * @param radius
+     * @return size_t
+     */
+    size_t countInRadius(layer l, size_t x, size_t y, size_t radius) const;
+    /**
+     * @brief Get the neighbors of a square which are set in a layer.
+     *
+     * @param l
+     * @param x
+     * @param y
+     * @return unsigned DIR_MASK of the direction of each neighbor
+     */
+    unsigned getNeighbors(layer l, size_t x, size_t y) const {
+        return (x > 0 && test(l, x - 1, y)) * DIR_MASK(LEFT) |
+               test(l, x + 1, y) * DIR_MASK(RIGHT) |
+               (y > 0 && test(l, x, y - 1)) * DIR_MASK(UP) |
+               test(l, x, y + 1) * DIR_MASK(DOWN);
+    }
+    /**
+     * @brief Get the moves allowed from a square: the neighbors which are
+     * halls, without going back.
+     *
+     * @param x
+     * @param y
+     * @param lastDir
+     * @return unsigned DIR_MASK of each allowed direction
+     */
+    unsigned getLegalMoves(size_t x, size_t y, dir lastDir) const;
+
+  private:
+    /**
+     * @brief Count the bits of a line of a layer between two columns.
+     *
+     * @param l
+     * @param y
+     * @param xMin
+     * @param xMax included
+     * @return size_t
+     */
+    size_t countRow(layer l, size_t y, size_t xMin, size_t xMax) const;
+
+    size_t _width, _height, _rowWords;
+    std::vector<uint64_t> _words;
+};
+
+#endif
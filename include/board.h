@@ -2,55 +2,136 @@
 #define BOARD_H
 
 #include "pacman.h"
+#include "pathtable.h"
+#include "pellets.h"
+#include <memory>
 
 /**
- * @brief The board is formed by vector of square's vector.
+ * @brief The board is formed by a flat grid of squares.
  * It defines each square of the map.
  */
 class board {
   public:
     board();
+    board(const board &) = delete;
+    board &operator=(const board &) = delete;
     ~board();
     /**
-     * @brief Get the Board object
+     * @brief Get a view on the board.
      *
-     * @return std::vector<std::vector<square>>
+     * @return gridView
      */
-    std::vector<std::vector<std::shared_ptr<square>>> getBoard();
+    gridView getBoard();
     /**
-     * @brief Set the state of each square with the map defined
-     * in "assets/pacman_board.txt".
+     * @brief Load a level and set the state of each square with its maze.
+     *
+     * @param fileName a text board or a compiled level file
+     */
+    void load(const std::string &fileName = LEVEL_FILE);
+    /**
+     * @brief Get the level of the board.
+     *
+     * @return const level&
+     */
+    const level &getLevel();
+    /**
+     * @brief Load the path tables of the board from the file of the level
+     * with the PATH_TABLE_EXTENSION extension, or compute them and save them
+     * in this file if it is missing or does not match the board.
+     *
+     * @note Must be called once the board is loaded. The tables are not
+     * computed for the mazes of more than PATH_TABLE_MAX_CELLS squares which
+     * are not walls, the shortest paths are then searched with A*.
+     *
+     * @param paths tables already loaded for the same maze, which are then
+     * shared instead of being loaded again, nullptr to load them
      */
-    void load();
+    void loadPaths(std::shared_ptr<const pathTable> paths = nullptr);
     /**
-     * @brief Change the element access of the board from [i][j] to [j][i].
+     * @brief Get the path tables of the board, to share them with the boards
+     * of the same maze.
      *
-     * @note The sprite returns "x" as the column and "y" as the line. The
-     * board is defined with "x" as the line and "y" as the column. So, we need
-     * to transpose the board to have the same access.
+     * @return std::shared_ptr<const pathTable> nullptr if they are not
+     * computed
      */
-    void transpose();
+    std::shared_ptr<const pathTable> getPathTables();
     /**
      * @brief Set the item on the square.
      *
-     * @note Initialise the position items (pacman, ghost, dot, powerup).
+     * @note Initialise the position items (pacman, ghost, dot, powerup)
+     * and the list of the remaining items.
      */
     void setItem();
     /**
      * @brief Get the list of the dot's position.
      *
-     * @return std::vector<Coordinate>
+     * @return const std::vector<Coordinate>&
      */
-    std::vector<Coordinate> getDotList();
+    const std::vector<Coordinate> &getDotList();
     /**
      * @brief Get the list of the powerup's position.
      *
-     * @return std::vector<Coordinate>
+     * @return const std::vector<Coordinate>&
+     */
+    const std::vector<Coordinate> &getPowerupList();
+    /**
+     * @brief Get the bitboard of the board.
+     *
+     * @return const bitboard&
+     *
+     * @note The actor layers are the ones given to the last call of
+     * setActors().
+     */
+    const bitboard &getBits();
+    /**
+     * @brief Put pacman and the ghosts in the actor layers of the bitboard.
+     *
+     * @param Pacman
+     * @param Ghosts
+     */
+    void setActors(pacman &Pacman, ghostPack &Ghosts);
+    /**
+     * @brief Save the remaining dots and powerups, one word per line.
+     *
+     * @param dots
+     * @param powerups
+     * @return true
+     * @return false if the maze is wider than 64 squares or higher than
+     * SNAPSHOT_MAX_ROWS squares
+     */
+    bool savePellets(uint64_t *dots, uint64_t *powerups);
+    /**
+     * @brief Restore the dots and powerups saved by savePellets().
+     *
+     * @note Only the squares which differ are changed, so that the lists of
+     * items are updated in constant time for each item eaten since the save.
+     *
+     * @param dots
+     * @param powerups
+     */
+    void restorePellets(const uint64_t *dots, const uint64_t *powerups);
+    /**
+     * @brief Get the Zobrist hash of the items of the board, kept up to date
+     * by the pellet tracker.
+     *
+     * @return uint64_t
+     */
+    uint64_t getHash();
+    /**
+     * @brief Compute the hash of the items again from the squares of the
+     * board, to check the one kept up to date.
+     *
+     * @return uint64_t
      */
-    std::vector<Coordinate> getPowerupList();
+    uint64_t computeHash();
 
   private:
-    std::vector<std::vector<std::shared_ptr<square>>> _board;
+    level _level;
+    std::string _pathFile;
+    grid _board;
+    // read only, shared by the boards of the same maze
+    std::shared_ptr<const pathTable> _paths;
+    pelletTracker _pellets;
 };
 
 #endif
\ No newline at end of file
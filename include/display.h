@@ -0,0 +1,166 @@
+#ifndef DISPLAY_H
+#define DISPLAY_H
+
+#include "atlas.h"
+
+// the whole frame is drawn when the changes cover more than 1/2 of it
+#define DIRTY_MAX_RATIO 2
+// the texts drawn by the surface backend are kept until there are 64
+#define TEXT_CACHE_SIZE 64
+
+enum backend {
+    BACKEND_SURFACE,  // blits in the surface of the window
+    BACKEND_TEXTURE,  // SDL renderer, on the GPU when there is one
+    BACKEND_SOFTWARE, // SDL renderer drawing with the CPU
+};
+
+/**
+ * @brief The display shows the frames built by graphic.h in a window or in
+ * a hidden surface.
+ *
+ * @note The surface backend blits the sprites of an atlas, scaled at startup,
+ * in the surface of the window. It compares each frame with the previous
+ * one and only draws and sends the areas where a drawing was added or
+ * removed: the actors, the eaten dots, the texts which changed. A text is
+ * drawn once in a surface of its own, kept while it is used, and then
+ * blitted at once. The renderer backends
+ * upload the sprite sheet once as a texture and send the consecutive sprites
+ * of a frame in one batch of geometry. In the texture the black pixels are
+ * always transparent, which draws the same frames since the sprites drawn
+ * without colour key are drawn on black.
+ */
+class display {
+  public:
+    display();
+    display(const display &) = delete;
+    display &operator=(const display &) = delete;
+    /**
+     * @brief Open the display of a window.
+     *
+     * @param Window
+     * @param spriteBoard the sprite sheet, kept by the caller
+     * @param Backend the texture backend falls back to the software renderer
+     * without GPU
+     * @return true
+     * @return false if the renderer or the texture can not be created
+     */
+    bool open(SDL_Window *Window, SDL_Surface *spriteBoard, backend Backend);
+    /**
+     * @brief Open the display of a surface which is not shown, the renderer
+     * backends use the software renderer.
+     *
+     * @param target
+     * @param spriteBoard the sprite sheet, kept by the caller
+     * @param Backend
+     * @return true
+     * @return false
+     */
+    bool open(SDL_Surface *target, SDL_Surface *spriteBoard, backend Backend);
+    /**
+     * @brief Release the renderer and the texture, before SDL_Quit.
+     */
+    void close();
+    /**
+     * @brief Draw a frame and show it in the window.
+     *
+     * @param list
+     */
+    void show(const DrawList &list);
+    /**
+     * @brief Draw and send the whole next frame, when the window has to be
+     * drawn again.
+     */
+    void invalidate() { _previous.clear(); }
+
+  private:
+    /**
+     * @brief Create the texture of the sprite sheet.
+     *
+     * @return true
+     * @return false
+     */
+    bool upload();
+    /**
+     * @brief Blit a frame in the surface.
+     *
+     * @param list
+     */
+    void showSurface(const DrawList &list);
+    /**
+     * @brief Find the areas which changed since the previous frame.
+     *
+     * @param list
+     * @return true
+     * @return false if the whole frame has to be drawn
+     */
+    bool findDirty(const DrawList &list);
+    /**
+     * @brief Blit a drawing in the surface.
+     *
+     * @param list the list of the drawing, with its text
+     * @param command
+     */
+    void blit(const DrawList &list, const DrawCommand &command);
+    /**
+     * @brief Get the surface where a text is drawn, draw it if it is not in
+     * the cache.
+     *
+     * @param str
+     * @return SDL_Surface* nullptr if the surface can not be created
+     */
+    SDL_Surface *getText(const std::string &str);
+    /**
+     * @brief Free the surfaces of the texts.
+     */
+    void clearTexts();
+    /**
+     * @brief Draw a frame with the renderer.
+     *
+     * @param list
+     */
+    void showTexture(const DrawList &list);
+    /**
+     * @brief Add a sprite to the current batch.
+     *
+     * @param src the area of the sprite sheet
+     * @param dst the area of the window
+     */
+    void addQuad(const SDL_Rect &src, const SDL_Rect &dst);
+    /**
+     * @brief Send the batch of sprites to the renderer.
+     */
+    void flushSprites();
+    /**
+     * @brief Send the batch of black areas to the renderer.
+     */
+    void flushFills();
+
+    /**
+     * @brief Build the atlas of the sprites in the format of the target.
+     *
+     * @return true
+     * @return false
+     */
+    bool buildAtlas();
+
+    SDL_Window *_window;
+    SDL_Surface *_target;
+    SDL_Surface *_sprites;
+    spriteAtlas _atlas;
+    std::unordered_map<std::string, SDL_Surface *> _texts;
+    // drawings of the previous frame and of the current one, sorted, and
+    // areas to draw again
+    DrawList _previous, _current;
+    std::vector<SDL_Rect> _dirty;
+    SDL_Renderer *_renderer;
+    SDL_Texture *_texture;
+    float _textureWidth, _textureHeight;
+    // batches of the renderer, kept between the frames
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    std::vector<SDL_Vertex> _vertices;
+    std::vector<int> _indices;
+#endif
+    std::vector<SDL_Rect> _fills;
+};
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+
+#include "graphic.h"
+#include <atomic>
+
+/**
+ * @brief Triple buffer of frames between the thread of the simulation, which
+ * builds them, and the thread of the display, which shows the latest one.
+ *
+ * @note The frame of a snapshot is its list of drawings: the actors, the
+ * dots left, the texts of the score and the flags of the game are already
+ * decided when it is published, so the display never reads the game. Each
+ * thread owns one of the three lists and the third one is exchanged with an
+ * atomic index, no thread waits for the other: the simulation overwrites a
+ * frame which was not shown and the display shows a frame again until a new
+ * one comes.
+ */
+class frameBuffer {
+  public:
+    frameBuffer();
+    frameBuffer(const frameBuffer &) = delete;
+    frameBuffer &operator=(const frameBuffer &) = delete;
+    /**
+     * @brief Get the frame built by the simulation, only used by its thread.
+     *
+     * @return DrawList&
+     */
+    DrawList &back() { return _frames[_back]; }
+    /**
+     * @brief Give the frame built by the simulation to the display.
+     */
+    void publish();
+    /**
+     * @brief Take the latest frame published, if any, for the display.
+     *
+     * @return true
+     * @return false if no frame was published since the last one taken
+     */
+    bool consume();
+    /**
+     * @brief Get the frame of the display, only used by its thread.
+     *
+     * @return const DrawList&
+     */
+    const DrawList &front() const { return _frames[_front]; }
+
+  private:
+    // set on the exchanged index when its frame was not taken yet
+    static const int NEW_FRAME = 4;
+
+    DrawList _frames[3];
+    int _back, _front;
+    std::atomic<int> _middle;
+};
+
+#endif
@@ -1,8 +1,11 @@
 #ifndef FRUIT_H
 #define FRUIT_H
 
-#include "lib.h"
-#include "square.h"
+#include "gameclock.h"
+#include "grid.h"
+#include "level.h"
+#include "snapshot.h"
+#include "zobrist.h"
 
 enum typeFruit {
     _NONE,
@@ -16,9 +19,6 @@ enum typeFruit {
     _KEY
 };
 
-#define FRUIT_X 10
-#define FRUIT_Y 15
-
 #define MIN_DOT_FRUIT 70
 #define MIN_DOT_FRUIT_STEP 100
 
@@ -39,7 +39,13 @@ enum typeFruit {
 
 class fruit {
   public:
-    fruit();
+    /**
+     * @brief Construct a new fruit.
+     *
+     * @param clock the clock of the game
+     * @param Level the level giving the square of the fruit
+     */
+    fruit(const gameClock &clock, const level &Level);
     ~fruit();
     /**
      * @brief Get the item of the fruit.
@@ -54,19 +60,39 @@ class fruit {
      * @param dotCounter
      * @param fruitCounter
      */
-    int updateFruit(std::vector<std::vector<std::shared_ptr<square>>> vecBoard,
-                    int dotCounter, int fruitCounter);
+    int updateFruit(gridView vecBoard, int dotCounter, int fruitCounter);
     /**
      * @brief Eat the fruit.
      *
      * @param vecBoard
      */
-    void eatFruit(std::vector<std::vector<std::shared_ptr<square>>> vecBoard);
+    void eatFruit(gridView vecBoard);
+    /**
+     * @brief Save the state of the fruit.
+     *
+     * @param state
+     */
+    void save(FruitState &state) const;
+    /**
+     * @brief Restore a state saved by save(), with the fruit on its square.
+     *
+     * @param state
+     * @param vecBoard
+     */
+    void restore(const FruitState &state, gridView vecBoard);
+    /**
+     * @brief Get the key of the fruit in the hash of the game.
+     *
+     * @return uint64_t
+     */
+    uint64_t getHash() const;
 
   private:
     typeFruit _fruit;
     int _lastFruit;
-    std::chrono::time_point<std::chrono::steady_clock> timeFruit1;
+    const gameClock *_clock;
+    Coordinate _pos;
+    tick_t timeFruit1;
 };
 
 #endif
\ No newline at end of file
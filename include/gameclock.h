@@ -0,0 +1,56 @@
+#ifndef GAMECLOCK_H
+#define GAMECLOCK_H
+
+#include "lib.h"
+#include <cstdint>
+
+#define TICKS_PER_SECOND 100 // one tick every 10ms
+
+/**
+ * @brief Date of the game, counted in ticks.
+ */
+typedef uint64_t tick_t;
+
+/**
+ * @brief The game clock counts the ticks played since the beginning of the
+ * game. All the timers of the game are read from it, so a game plays the same
+ * whatever the speed at which the ticks are computed.
+ */
+class gameClock {
+  public:
+    gameClock() : _tick(0) {}
+    /**
+     * @brief Go to the next tick.
+     */
+    void tick() { _tick++; }
+    /**
+     * @brief Go back to the first tick.
+     */
+    void reset() { _tick = 0; }
+    /**
+     * @brief Go to a tick, when a game is restored.
+     *
+     * @param tick
+     */
+    void set(tick_t tick) { _tick = tick; }
+    /**
+     * @brief Get the current tick.
+     *
+     * @return tick_t
+     */
+    tick_t now() const { return _tick; }
+    /**
+     * @brief Get the time spent since a tick.
+     *
+     * @param start
+     * @return double the time in seconds
+     */
+    double getElapsed(tick_t start) const {
+        return double(_tick - start) / TICKS_PER_SECOND;
+    }
+
+  private:
+    tick_t _tick;
+};
+
+#endif
@@ -1,25 +1,15 @@
 #ifndef GHOST_H
 #define GHOST_H
 
+#include "gameclock.h"
+#include "level.h"
+#include "pathtable.h"
+#include "rng.h"
 #include "shortestpath.h"
-#include <random>
 
-enum color { RED, PINK, BLUE, ORANGE };
-
-#define GHOST_INIT_X 10
-#define GHOST_INIT_Y 10
 #define GHOST_CENTER_X 0
 #define GHOST_CENTER_Y 4
 
-#define RED_GHOST_INIT_X 10
-#define RED_GHOST_INIT_Y 13
-#define PINK_GHOST_INIT_X 10
-#define PINK_GHOST_INIT_Y 13
-#define BLUE_GHOST_INIT_X 9
-#define BLUE_GHOST_INIT_Y 12
-#define ORANGE_GHOST_INIT_X 11
-#define ORANGE_GHOST_INIT_Y 12
-
 #define GHOST_SLOW_SPEED 1
 #define GHOST_SLOW_RANGE_CENTER GHOST_SLOW_SPEED - 1
 #define GHOST_SPEED 2
@@ -58,9 +48,21 @@ enum color { RED, PINK, BLUE, ORANGE };
 
 enum mode { ANY, CHASE, SCATTER, FRIGHTENED };
 
+class ghostPack;
+
 class ghost {
   public:
-    ghost();
+    /**
+     * @brief Construct a new ghost.
+     *
+     * @param pack the pack storing the position of the ghost
+     * @param id the index of the ghost in the pack
+     * @param clock the clock of the game
+     * @param Level the level of the game
+     * @param random the random number generator of the game
+     */
+    ghost(ghostPack &pack, size_t id, const gameClock &clock,
+          const level &Level, rng &random);
     ~ghost();
     /**
      * @brief Set the color of the ghost.
@@ -89,9 +91,8 @@ class ghost {
      * @param dotCounter
      * @param life
      */
-    void
-    updateInHouse(std::vector<std::vector<std::shared_ptr<square>>> vecBoard,
-                  int level, int dotCounter, int life, time_t noEatenDotTimer1);
+    void updateInHouse(gridView vecBoard, int level, int dotCounter, int life,
+                       tick_t noEatenDotTimer1);
     /**
      * @brief Ghost go back to the house.
      *
@@ -109,8 +110,7 @@ class ghost {
      *
      * @param vecBoard
      */
-    void
-    returnHouse(std::vector<std::vector<std::shared_ptr<square>>> vecBoard);
+    void returnHouse(gridView vecBoard);
     /**
      * @brief Set the frightened object.
      *
@@ -124,6 +124,12 @@ class ghost {
      * @return false
      */
     bool isFrightened();
+    /**
+     * @brief Get the current mode of the ghost.
+     *
+     * @return mode
+     */
+    mode getMode();
     /**
      * @brief Get the sprite position of the ghost.
      *
@@ -136,26 +142,11 @@ class ghost {
      * @return std::pair<size_t, size_t>
      */
     std::pair<size_t, size_t> getEatenPosition();
-    /**
-     * @brief Update the sprite position of the ghost.
-     *
-     * @param count - frame number
-     * @note The sprite position represents the pixel position of the ghost.
-     */
-    void updatePos();
     /**
      * @brief Update the board position of the ghost.
      *
      */
     void updateCoord();
-    /**
-     * @brief Wait the ghost to be in the center of a square in function of
-     * the ghost speed, of the direction and of the sprite position.
-     *
-     * @return true
-     * @return false
-     */
-    bool waitSquareCenter();
     /**
      * @brief Get the last direction of the ghost.
      *
@@ -168,9 +159,9 @@ class ghost {
      *
      * @param vecBoard
      */
-    void updateDir(std::vector<std::vector<std::shared_ptr<square>>> vecBoard,
-                   size_t xPac, size_t yPac, dir dirPac, int level,
-                   int dotCounter, int life, time_t noEatenDotTimer1);
+    void updateDir(gridView vecBoard, size_t xPac, size_t yPac, dir dirPac,
+                   int level, int dotCounter, int life,
+                   tick_t noEatenDotTimer1);
     /**
      * @brief Update direction of red ghost. Red ghost is following the pacman.
      *
@@ -182,9 +173,7 @@ class ghost {
      * @param dotCounter
      * @param life
      */
-    void
-    updateDirRed(std::vector<std::vector<std::shared_ptr<square>>> vecBoard,
-                 size_t xPac, size_t yPac);
+    void updateDirRed(gridView vecBoard, size_t xPac, size_t yPac);
     /**
      * @brief Update direction of pink ghost. Pink ghost is anticipating the
      * pacman, it is going to the position of the pacman + 4.
@@ -194,9 +183,8 @@ class ghost {
      * @param yPac
      * @param dirPac
      */
-    void
-    updateDirPink(std::vector<std::vector<std::shared_ptr<square>>> vecBoard,
-                  size_t xPac, size_t yPac, dir dirPac);
+    void updateDirPink(gridView vecBoard, size_t xPac, size_t yPac,
+                       dir dirPac);
     /**
      * @brief Update direction of blue ghost. Swap between the chase mode of red
      * and pink ghost.
@@ -206,9 +194,8 @@ class ghost {
      * @param yPac
      * @param dirPac
      */
-    void
-    updateDirBlue(std::vector<std::vector<std::shared_ptr<square>>> vecBoard,
-                  size_t xPac, size_t yPac, dir dirPac);
+    void updateDirBlue(gridView vecBoard, size_t xPac, size_t yPac,
+                       dir dirPac);
     /**
      * @brief Update direction of orange ghost. Orange ghost is following the
      * pacman if the distance between the pacman and the ghost is greater than
@@ -219,9 +206,7 @@ class ghost {
      * @param yPac
      * @param dirPac
      */
-    void
-    updateDirOrange(std::vector<std::vector<std::shared_ptr<square>>> vecBoard,
-                    size_t xPac, size_t yPac);
+    void updateDirOrange(gridView vecBoard, size_t xPac, size_t yPac);
     /**
      * @brief Update the direction of the ghost in scatter mode.
      *
@@ -229,9 +214,15 @@ class ghost {
      * @param x
      * @param y
      */
-    void updateDirScatterMode(
-        std::vector<std::vector<std::shared_ptr<square>>> vecBoard, size_t x,
-        size_t y);
+    void updateDirScatterMode(gridView vecBoard, size_t x, size_t y);
+    /**
+     * @brief Take one step of the patrol around the scatter corner.
+     *
+     * @param vecBoard
+     * @param x
+     * @param y
+     */
+    void patrol(gridView vecBoard, size_t x, size_t y);
     /**
      * @brief Update the direction in run away mode. Ghost is going to the
      * opposite direction of the pacman.
@@ -241,8 +232,7 @@ class ghost {
      * @param yPac
      * @param dirPac
      */
-    void updateDirRunAwayMode(
-        std::vector<std::vector<std::shared_ptr<square>>> vecBoard);
+    void updateDirRunAwayMode(gridView vecBoard);
     /**
      * @brief Swap between chase and scatter mode.
      *
@@ -250,10 +240,24 @@ class ghost {
     void swapMode(int level);
 
   private:
+    friend class ghostPack;
+
+    /**
+     * @brief Get the pixel coordinates, stored in the pack.
+     *
+     * @return size_t&
+     */
+    size_t &xPixel();
+    size_t &yPixel();
+
     color _color;
+    ghostPack *_pack;
+    size_t _id;
+    const gameClock *_clock;
+    const level *_level;
     // board coordinates corresponding to coordinates of the board vector
-    // pixel coordinates corresponding to the sprite position
-    size_t _xBoard, _yBoard, _xPixel, _yPixel, _xPixelEaten, _yPixelEaten;
+    // pixel coordinates of the sprite when the ghost was eaten
+    size_t _xBoard, _yBoard, _xPixelEaten, _yPixelEaten;
     dir _lastDir;
     mode _mode;
     int _swapMode;
@@ -267,11 +271,11 @@ class ghost {
     // during 12s
     bool _blueRed, _bluePink;
     // timer for switching mode
-    time_t modeTimer1;
+    tick_t modeTimer1;
     // timer orange ghost
-    time_t blueTimer1;
-    // random number generator
-    std::mt19937 _rng;
+    tick_t blueTimer1;
+    // random number generator of the game
+    rng *_rng;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,185 @@
+#ifndef GHOSTPACK_H
+#define GHOSTPACK_H
+
+#include "ghost.h"
+#include "snapshot.h"
+#include "zobrist.h"
+
+// bits of the speed state of a ghost, index of the speed tables
+#define GHOST_STATE_FEAR 1
+#define GHOST_STATE_RETURN 2
+#define GHOST_STATE_HOUSE 4
+#define GHOST_STATE_TUNNEL 8
+#define NB_GHOST_STATES 16
+
+/**
+ * @brief The ghosts of a game, with the state read at each tick stored in
+ * parallel arrays.
+ *
+ * @note The pixel positions are only stored in the pack. The direction, the
+ * center of the square and the speed state are copies of the state of each
+ * ghost, refreshed each time the pack changes a ghost, so the ghosts must be
+ * changed through the pack. Moving the ghosts, waiting for the center of the
+ * squares and the collisions with pacman are then done in one pass over the
+ * arrays, with the speed read in a table indexed by the speed state. A pack
+ * can hold any number of ghosts, the colors are repeated after the fourth.
+ */
+class ghostPack {
+  public:
+    /**
+     * @brief Construct an empty pack.
+     *
+     * @param clock the clock of the game
+     * @param Level the level of the game
+     * @param random the random number generator of the game
+     */
+    ghostPack(const gameClock &clock, const level &Level, rng &random);
+    ghostPack(const ghostPack &other);
+    ghostPack &operator=(const ghostPack &other);
+    ~ghostPack();
+    /**
+     * @brief Replace the ghosts with new ghosts at their initial position.
+     *
+     * @param nbGhosts
+     */
+    void reset(size_t nbGhosts);
+    /**
+     * @brief Get the number of ghosts.
+     *
+     * @return size_t
+     */
+    size_t size() const { return _vecGhost.size(); }
+    /**
+     * @brief Get a ghost, to be read only.
+     *
+     * @param i
+     * @return ghost&
+     */
+    ghost &operator[](size_t i) { return _vecGhost[i]; }
+    std::vector<ghost>::iterator begin() { return _vecGhost.begin(); }
+    std::vector<ghost>::iterator end() { return _vecGhost.end(); }
+    /**
+     * @brief Wait each ghost to be in the center of a square, see
+     * isAtCenter().
+     */
+    void waitSquareCenter();
+    /**
+     * @brief Check if a ghost was in the center of a square at the last call
+     * of waitSquareCenter().
+     *
+     * @param i
+     * @return true
+     * @return false
+     */
+    bool isAtCenter(size_t i) const { return _atCenter[i]; }
+    /**
+     * @brief Update the direction of the ghosts in the center of a square.
+     *
+     * @param vecBoard
+     * @param xPac
+     * @param yPac
+     * @param dirPac
+     * @param level
+     * @param dotCounter
+     * @param life
+     * @param noEatenDotTimer1
+     */
+    void updateDir(gridView vecBoard, size_t xPac, size_t yPac, dir dirPac,
+                   int level, int dotCounter, int life,
+                   tick_t noEatenDotTimer1);
+    /**
+     * @brief Update the direction of one ghost.
+     *
+     * @param i
+     * @see updateDir()
+     */
+    void updateDir(size_t i, gridView vecBoard, size_t xPac, size_t yPac,
+                   dir dirPac, int level, int dotCounter, int life,
+                   tick_t noEatenDotTimer1);
+    /**
+     * @brief Move the ghosts in their direction.
+     */
+    void updatePos();
+    /**
+     * @brief Set the frightened state of the ghosts out of the ghost house.
+     *
+     * @param isFear
+     */
+    void setFrightened(bool isFear);
+    /**
+     * @brief Make a ghost go back to the house.
+     *
+     * @param i
+     */
+    void setReturnHouse(size_t i);
+    /**
+     * @brief Find the ghosts in contact with a position.
+     *
+     * @param x pixel position
+     * @param y pixel position
+     * @param contact the distance in pixels of a contact
+     * @return const std::vector<uint8_t>& 1 for each ghost in contact
+     */
+    const std::vector<uint8_t> &findContact(size_t x, size_t y, int contact);
+    /**
+     * @brief Save the state of the ghosts.
+     *
+     * @param states an array of size() states
+     */
+    void save(GhostState *states) const;
+    /**
+     * @brief Restore the ghosts saved by save(), the ghosts are only created
+     * again if their number changed.
+     *
+     * @param states
+     * @param nbGhosts
+     */
+    void restore(const GhostState *states, size_t nbGhosts);
+    /**
+     * @brief Get the key of the ghosts in the hash of the game.
+     *
+     * @return uint64_t
+     */
+    uint64_t getHash() const;
+    /**
+     * @brief Get the sprite position of a ghost.
+     *
+     * @param i
+     * @return std::pair<size_t, size_t>
+     */
+    std::pair<size_t, size_t> getPos(size_t i) const {
+        return std::make_pair(_xPixel[i], _yPixel[i]);
+    }
+
+  private:
+    friend class ghost;
+
+    /**
+     * @brief Copy the state of a ghost in the arrays.
+     *
+     * @param i
+     */
+    void sync(size_t i);
+    /**
+     * @brief Make the ghosts point to this pack.
+     */
+    void bind();
+
+    const gameClock *_clock;
+    const level *_level;
+    rng *_rng;
+    std::vector<ghost> _vecGhost;
+    // pixel positions, only stored here
+    std::vector<size_t> _xPixel, _yPixel;
+    // copies of the state of the ghosts
+    std::vector<size_t> _xCenter, _yCenter;
+    std::vector<uint8_t> _dir, _state;
+    // result of the last waitSquareCenter() and findContact()
+    std::vector<uint8_t> _atCenter, _contact;
+};
+
+inline size_t &ghost::xPixel() { return _pack->_xPixel[_id]; }
+
+inline size_t &ghost::yPixel() { return _pack->_yPixel[_id]; }
+
+#endif
@@ -1,7 +1,7 @@
 #ifndef GRAPHIC_H
 #define GRAPHIC_H
 
-#include "board.h"
+#include "simulation.h"
 #include <SDL2/SDL.h>
 #include <map>
 
@@ -12,23 +12,67 @@
 #define FRUIT_SCORE_DISPLAY_TIME 2
 
 /**
- * @brief Initialize SDL and create the window
- * and the surface to draw on
+ * @brief Get the sprite of a score.
+ * @param score
+ * @return const SDL_Rect* nullptr if there is no sprite for the score
+ */
+const SDL_Rect *getScoreSprite(int score);
+/**
+ * @brief Get the sprite of a character, blank if the character has none. The
+ * sprites are in a table of the 256 characters.
+ * @param c
+ * @return const SDL_Rect*
+ */
+const SDL_Rect *getCharSprite(char c);
+#define GLYPH_SIZE 16 // size of the characters in the window
+
+/**
+ * @brief One drawing of a frame: a sprite of the sprite sheet scaled in an
+ * area of the window, a text on a black background in the area, or an area
+ * filled with black when the source is empty.
+ */
+struct DrawCommand {
+    SDL_Rect src;
+    SDL_Rect dst;
+    bool colorKey; // the black pixels of the sprite are transparent
+    int text;      // index of the text in the list, -1 for the other drawings
+};
+
+/**
+ * @brief The drawings of a frame, in the order they are drawn. The list is
+ * built from the game and shown by a display.
+ */
+struct DrawList {
+    std::vector<DrawCommand> commands;
+    std::vector<std::string> texts;
+    /**
+     * @brief Remove the drawings and the texts.
+     */
+    void clear() {
+        commands.clear();
+        texts.clear();
+    }
+};
+
+/**
+ * @brief List every sprite drawn by the screens, once per size it is drawn
+ * with, in areas placed at the origin.
+ * @param list the list of sprites, cleared first
+ */
+void listSprites(DrawList &list);
+/**
+ * @brief Create the window and load the sprite sheet
  * @param Window
- * @param windowSurf
  * @param spriteBoard
  */
-void init(SDL_Window **Window, SDL_Surface **windowSurf,
-          SDL_Surface **spriteBoard);
+void init(SDL_Window **Window, SDL_Surface **spriteBoard);
 /**
- * @brief Draw the game on the window
- * and update the window.
+ * @brief Build the frame of the game, on one thread at a time.
  * Make movement of the ghost and pacman
- * @param windowSurf
- * @param spriteBoard
+ * @param list the list of drawings, cleared first
  * @param count the number of frame
  * @param Pacman the pacman
- * @param vecGhost the vector of ghost
+ * @param Ghosts the ghosts
  * @param vecDot the vector of dot
  * @param vecPowerup the vector of powerup
  * @param fruit the fruit to display
@@ -37,39 +81,34 @@ void init(SDL_Window **Window, SDL_Surface **windowSurf,
  * @param death variable to know if pacman is dead and display the animation
  * @param start variable to know if the game is started
  * @param curLevel the current level
+ * @param Clock the clock of the game
  * @return the number of frame
  */
-int draw(SDL_Surface **windowSurf, SDL_Surface **spriteBoard, int count,
-         pacman Pacman, std::vector<std::shared_ptr<ghost>> vecGhost,
-         std::vector<Coordinate> vecDot, std::vector<Coordinate> vecPowerup,
-         typeFruit fruit, int curScore, int highScore, short death, bool start,
-         int curLevel);
+int buildFrame(DrawList &list, int count, pacman &Pacman, ghostPack &Ghosts,
+               const std::vector<Coordinate> &vecDot,
+               const std::vector<Coordinate> &vecPowerup, typeFruit fruit,
+               int curScore, int highScore, short death, bool start,
+               int curLevel, const gameClock &Clock);
 /**
- * @brief Draw strings on the window
- * @param windowSurf
- * @param spriteBoard
+ * @brief Add a string on a black background to a frame
+ * @param list
  * @param x the x position to display the string
  * @param y the y position to display the string
  * @param str the string to display
-
-*/
-void drawString(SDL_Surface **windowSurf, SDL_Surface **spriteBoard, int x,
-                int y, std::string str);
+ */
+void addString(DrawList &list, int x, int y, const std::string &str);
 /**
- * @brief Draw the menu before the game
- * @param windowSurf
- * @param spriteBoard
+ * @brief Build the menu before the game
+ * @param list the list of drawings, cleared first
  * @param highScore the high score
  */
-void intro(SDL_Surface **windowSurf, SDL_Surface **spriteBoard, int highScore);
+void buildIntro(DrawList &list, int highScore);
 /**
- * @brief Draw the game over screen
- * @param windowSurf
- * @param spriteBoard
+ * @brief Build the game over screen
+ * @param list the list of drawings, cleared first
  * @param curScore the current score
  * @param highScore the high score
  */
-void gameOver(SDL_Surface **windowSurf, SDL_Surface **spriteBoard, int curScore,
-              int highScore);
+void buildGameOver(DrawList &list, int curScore, int highScore);
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,162 @@
+#ifndef GRID_H
+#define GRID_H
+
+#include "lib.h"
+#include "square.h"
+#include <atomic>
+
+class pathTable;
+class pelletTracker;
+
+/**
+ * @brief Non-owning view on the squares of a grid.
+ *
+ * @note The view is only a pointer and the dimensions of the grid, it is
+ * passed by value to the gameplay functions instead of the whole map. It stays
+ * valid as long as the grid it comes from is not resized. The view also gives
+ * access to the path tables and to the remaining items of the board if they
+ * are computed.
+ */
+class gridView {
+  public:
+    gridView()
+        : _squares(nullptr), _width(0), _height(0), _stride(0),
+          _paths(nullptr), _pellets(nullptr) {}
+    gridView(square *squares, size_t width, size_t height, size_t stride,
+             const pathTable *paths = nullptr,
+             pelletTracker *pellets = nullptr)
+        : _squares(squares), _width(width), _height(height), _stride(stride),
+          _paths(paths), _pellets(pellets) {}
+    /**
+     * @brief Get the number of columns of the grid.
+     *
+     * @return size_t
+     */
+    size_t getWidth() const { return _width; }
+    /**
+     * @brief Get the number of lines of the grid.
+     *
+     * @return size_t
+     */
+    size_t getHeight() const { return _height; }
+    /**
+     * @brief Check if the position is inside the grid.
+     *
+     * @param x
+     * @param y
+     * @return true
+     * @return false
+     */
+    bool isInside(size_t x, size_t y) const {
+        return x < _width && y < _height;
+    }
+    /**
+     * @brief Get the index of the square in the flat array.
+     *
+     * @param x
+     * @param y
+     * @return size_t
+     */
+    size_t index(size_t x, size_t y) const { return y * _stride + x; }
+    /**
+     * @brief Get the square at the position.
+     *
+     * @param x
+     * @param y
+     * @return square&
+     */
+    square &at(size_t x, size_t y) const { return _squares[index(x, y)]; }
+    /**
+     * @brief Get the path tables of the board.
+     *
+     * @return const pathTable* nullptr if they are not computed
+     */
+    const pathTable *getPaths() const { return _paths; }
+    /**
+     * @brief Get the remaining items of the board, to be updated each time an
+     * item is eaten.
+     *
+     * @return pelletTracker* nullptr if they are not tracked
+     */
+    pelletTracker *getPellets() const { return _pellets; }
+
+  private:
+    square *_squares;
+    size_t _width, _height, _stride;
+    const pathTable *_paths;
+    pelletTracker *_pellets;
+};
+
+/**
+ * @brief The grid stores all the squares of the map in one contiguous array,
+ * line after line, so that the square (x, y) is at the index y * width + x.
+ */
+class grid {
+  public:
+    grid();
+    grid(size_t width, size_t height);
+    /**
+     * @brief Copy the squares seen by the view in a new grid.
+     *
+     * @param view
+     */
+    explicit grid(gridView view);
+    grid(const grid &other);
+    grid(grid &&other) = default;
+    grid &operator=(const grid &other);
+    grid &operator=(grid &&other) = default;
+    ~grid();
+    /**
+     * @brief Resize the grid, all the squares are reset.
+     *
+     * @param width
+     * @param height
+     */
+    void resize(size_t width, size_t height);
+    /**
+     * @brief Get the number of columns of the grid.
+     *
+     * @return size_t
+     */
+    size_t getWidth() const { return _width; }
+    /**
+     * @brief Get the number of lines of the grid.
+     *
+     * @return size_t
+     */
+    size_t getHeight() const { return _height; }
+    /**
+     * @brief Get the square at the position.
+     *
+     * @param x
+     * @param y
+     * @return square&
+     */
+    square &at(size_t x, size_t y) { return _squares[y * _width + x]; }
+    /**
+     * @brief Get a view on the grid.
+     *
+     * @param paths the path tables computed for the grid
+     * @param pellets the items tracked on the grid
+     * @return gridView
+     */
+    gridView getView(const pathTable *paths = nullptr,
+                     pelletTracker *pellets = nullptr);
+    /**
+     * @brief Get the number of copies of a grid made since the beginning of
+     * the program.
+     *
+     * @return size_t
+     *
+     * @note The counter is only incremented if compiled with the debug
+     * option, it allows to check that the gameplay only uses views.
+     */
+    static size_t getCopyCount();
+
+  private:
+    size_t _width, _height;
+    std::vector<square> _squares;
+    static std::atomic<size_t> _copyCount;
+};
+
+#endif
@@ -0,0 +1,286 @@
+#ifndef LEVEL_H
+#define LEVEL_H
+
+#include "lib.h"
+#include <cstdint>
+#include <string>
+
+#define LEVEL_FILE "assets/pacman_board.txt"
+#define LEVEL_MAGIC 0x564c4d50 // "PMLV"
+#define LEVEL_VERSION 1
+
+enum color { RED, PINK, BLUE, ORANGE };
+
+#define NB_COLORS 4
+
+// metadata of the classic maze, given to the text boards
+#define PACMAN_INIT_X 10
+#define PACMAN_INIT_Y 20
+
+#define GHOST_INIT_X 10
+#define GHOST_INIT_Y 10
+
+#define RED_GHOST_INIT_X 10
+#define RED_GHOST_INIT_Y 13
+#define PINK_GHOST_INIT_X 10
+#define PINK_GHOST_INIT_Y 13
+#define BLUE_GHOST_INIT_X 9
+#define BLUE_GHOST_INIT_Y 12
+#define ORANGE_GHOST_INIT_X 11
+#define ORANGE_GHOST_INIT_Y 12
+
+#define RED_GHOST_SCATTER_X 19
+#define RED_GHOST_SCATTER_Y 1
+#define PINK_GHOST_SCATTER_X 1
+#define PINK_GHOST_SCATTER_Y 1
+#define BLUE_GHOST_SCATTER_X 19
+#define BLUE_GHOST_SCATTER_Y 25
+#define ORANGE_GHOST_SCATTER_X 1
+#define ORANGE_GHOST_SCATTER_Y 25
+
+#define FRUIT_X 10
+#define FRUIT_Y 15
+
+#define TUNNEL_DEPTH 4 // the ghosts are slow on the 5 squares at each end
+
+/**
+ * @brief Rectangle of squares, both corners included.
+ */
+struct Zone {
+    int xMin;
+    int yMin;
+    int xMax;
+    int yMax;
+};
+
+/**
+ * @brief Header of a compiled level file. It is followed by the powerups,
+ * the empty zones, the straight zones and the states of the squares, one byte
+ * per square line after line.
+ */
+struct LevelHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+    uint32_t tunnelDepth;
+    Coordinate pacman;
+    Coordinate ghostExit;
+    Coordinate fruit;
+    Coordinate home[NB_COLORS];
+    Coordinate scatter[NB_COLORS];
+    uint32_t nbPowerups;
+    uint32_t nbEmptyZones;
+    uint32_t nbStraightZones;
+};
+
+/**
+ * @brief The level describes a maze: the state of its squares and the
+ * positions used by the rules of the game (spawns, ghost house, tunnels,
+ * powerups).
+ *
+ * @note A level is read from a text board, which gets the metadata of the
+ * classic maze, or from a compiled level file. A compiled file is mapped in
+ * memory and its states are read in place, so a large maze is ready without
+ * being parsed. A line whose both border squares are not walls is a tunnel,
+ * as for the path tables. The ghost house is below the exit of the ghosts:
+ * the door first and then the line where the ghosts wait.
+ */
+class level {
+  public:
+    level();
+    level(const level &) = delete;
+    level &operator=(const level &) = delete;
+    ~level();
+    /**
+     * @brief Load a text board or a compiled level file, recognized by its
+     * first bytes.
+     *
+     * @param fileName
+     * @return true
+     * @return false if the file is missing or invalid
+     */
+    bool load(const std::string &fileName);
+    /**
+     * @brief Save the level in a compiled level file.
+     *
+     * @param fileName
+     * @return true
+     * @return false
+     */
+    bool save(const std::string &fileName) const;
+    /**
+     * @brief Repeat the maze horizontally, the tunnels of the copies next to
+     * each other are joined. The actors stay in the first copy and the
+     * scatter corners move to the corners of the whole maze.
+     *
+     * @param nbTiles
+     */
+    void tile(size_t nbTiles);
+    /**
+     * @brief Get the number of columns of the maze.
+     *
+     * @return size_t
+     */
+    size_t getWidth() const { return _width; }
+    /**
+     * @brief Get the number of lines of the maze.
+     *
+     * @return size_t
+     */
+    size_t getHeight() const { return _height; }
+    /**
+     * @brief Get the state of a square (HALL, WALL or DOOR).
+     *
+     * @param x
+     * @param y
+     * @return uint8_t
+     */
+    uint8_t getState(size_t x, size_t y) const {
+        return _states[y * _width + x];
+    }
+    /**
+     * @brief Check if a line is a tunnel.
+     *
+     * @param y
+     * @return true
+     * @return false
+     */
+    bool isTunnel(size_t y) const { return y < _height && _tunnel[y]; }
+    /**
+     * @brief Check if a square is at one end of a tunnel, where the ghosts
+     * are slow.
+     *
+     * @param x
+     * @param y
+     * @return true
+     * @return false
+     */
+    bool isTunnelEnd(size_t x, size_t y) const {
+        return isTunnel(y) &&
+               (x <= _tunnelDepth || x + _tunnelDepth >= _width - 1);
+    }
+    /**
+     * @brief Get the number of squares at each end of a tunnel, minus one.
+     *
+     * @return size_t
+     */
+    size_t getTunnelDepth() const { return _tunnelDepth; }
+    /**
+     * @brief Check if no dot is put on a square.
+     *
+     * @param x
+     * @param y
+     * @return true
+     * @return false
+     */
+    bool isEmpty(size_t x, size_t y) const {
+        return _flags[y * _width + x] & FLAG_EMPTY;
+    }
+    /**
+     * @brief Check if the ghosts can only go left or right on a square.
+     *
+     * @param x
+     * @param y
+     * @return true
+     * @return false
+     */
+    bool isStraight(size_t x, size_t y) const {
+        return x < _width && y < _height &&
+               (_flags[y * _width + x] & FLAG_STRAIGHT);
+    }
+    /**
+     * @brief Get the spawn of pacman.
+     *
+     * @return Coordinate
+     */
+    Coordinate getPacmanSpawn() const { return _header.pacman; }
+    /**
+     * @brief Get the square above the door of the ghost house, where the
+     * ghosts leave the house.
+     *
+     * @return Coordinate
+     */
+    Coordinate getGhostExit() const { return _header.ghostExit; }
+    /**
+     * @brief Get the square of the ghost house of a ghost, the red ghost
+     * starts at the exit.
+     *
+     * @param c
+     * @return Coordinate
+     */
+    Coordinate getGhostHome(color c) const { return _header.home[c]; }
+    /**
+     * @brief Get the corner of a ghost in scatter mode.
+     *
+     * @param c
+     * @return Coordinate
+     */
+    Coordinate getScatter(color c) const { return _header.scatter[c]; }
+    /**
+     * @brief Get the square of the fruit.
+     *
+     * @return Coordinate
+     */
+    Coordinate getFruit() const { return _header.fruit; }
+    /**
+     * @brief Get the squares of the powerups.
+     *
+     * @return const std::vector<Coordinate>&
+     */
+    const std::vector<Coordinate> &getPowerups() const { return _powerups; }
+    /**
+     * @brief Get a hash of the maze and of its positions, which changes when
+     * the level is edited.
+     *
+     * @return uint64_t
+     */
+    uint64_t getHash() const;
+
+  private:
+    static const uint8_t FLAG_EMPTY = 1;
+    static const uint8_t FLAG_STRAIGHT = 2;
+
+    /**
+     * @brief Read a text board and give it the metadata of the classic maze.
+     *
+     * @param fileName
+     * @return true
+     * @return false
+     */
+    bool loadText(const std::string &fileName);
+    /**
+     * @brief Map a compiled level file in memory.
+     *
+     * @param fileName
+     * @return true
+     * @return false
+     */
+    bool loadCompiled(const std::string &fileName);
+    /**
+     * @brief Release the mapped file, if any.
+     */
+    void unmap();
+    /**
+     * @brief Check the metadata and compute the tunnels and the flags of the
+     * squares.
+     *
+     * @return true
+     * @return false if a position is outside the maze
+     */
+    bool index();
+
+    size_t _width, _height, _tunnelDepth;
+    LevelHeader _header;
+    std::vector<Coordinate> _powerups;
+    std::vector<Zone> _emptyZones, _straightZones;
+    // states of the squares, in the mapped file or in _ownStates
+    const uint8_t *_states;
+    std::vector<uint8_t> _ownStates;
+    void *_map;
+    size_t _mapSize;
+    // tunnel flag of each line and flags of each square
+    std::vector<uint8_t> _tunnel, _flags;
+};
+
+#endif
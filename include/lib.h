@@ -1,7 +1,7 @@
 #ifndef LIB_H
 #define LIB_H
 
-#include <chrono>
+#include <cmath>
 #include <fstream>
 #include <iostream>
 #include <memory>
@@ -23,11 +23,6 @@
 
 enum dir { LEFT, RIGHT, UP, DOWN, NONE };
 
-#define time_t                          \
-    std::chrono::time_point<            \
-        std::chrono::_V2::steady_clock, \
-        std::chrono::duration<long int, std::ratio<1, 1000000000>>>
-
 struct Coordinate {
     int x;
     int y;
@@ -0,0 +1,126 @@
+#ifndef MCTS_H
+#define MCTS_H
+
+#include "simulation.h"
+#include <chrono>
+#include <memory>
+
+#define MCTS_DEFAULT_TIME 10    // milliseconds to choose each direction
+#define MCTS_ROLLOUT_MOVES 16   // squares crossed after the tree by a rollout
+#define MCTS_MAX_MOVE_TICKS 64  // ticks of a move, which crosses one square
+#define MCTS_MAX_NODES 65536    // nodes of the tree of each thread
+#define MCTS_EXPLORATION 0.5    // weight of the exploration in UCT
+#define MCTS_DISCOUNT 0.95      // weight of a point one square later
+#define MCTS_SCORE_SCALE 200    // points of the best value without clearing
+#define MCTS_RANDOM_ROLLOUT 4   // one rollout move out of 4 is random
+#define MCTS_DISTANCE_VALUE 0.1 // value of an item at the end of a rollout
+#define MCTS_DISTANCE_SCALE 32  // squares to an item which is worth nothing
+
+/**
+ * @brief Options of the search.
+ */
+struct MctsOptions {
+    // threads which play the rollouts
+    size_t threads;
+    // milliseconds to choose a direction
+    int time;
+    // rollouts to choose a direction, shared by the threads, 0 for no
+    // limit: with a limit and a long time the choices are reproducible
+    size_t iterations;
+};
+
+/**
+ * @brief Node of a search tree: a move of pacman from the square where the
+ * move of its parent ends.
+ */
+struct MctsNode {
+    double value; // sum of the values of the rollouts through the node
+    uint32_t visits;
+    uint32_t firstChild; // children are consecutive, 0 before the expansion
+    uint8_t nbChildren;
+    uint8_t move;
+    // the game ends a life or a level during the move, the value of the
+    // node is then always terminalValue
+    bool terminal;
+    bool expanded;
+    float terminalValue;
+};
+
+/**
+ * @brief Autopilot which chooses the direction of pacman by Monte Carlo tree
+ * search over the headless simulation.
+ *
+ * @note A direction is only chosen where pacman can turn, at the center of a
+ * square: the moves of the tree go from one center to the next one. The
+ * game is deterministic from a snapshot, so the search plays each path of
+ * the tree again from the snapshot of the game, then a rollout which goes to
+ * the nearest item or turns at random. The value of a rollout is 0 if pacman
+ * dies, 1 if he clears the level, between 0.5 and 1 otherwise with the
+ * discounted score and the distance to the nearest item at the end. Each
+ * thread builds its own tree on its own simulation (root parallelization),
+ * the visits of the first moves are added at the end and the most visited
+ * one is played.
+ */
+class mcts {
+  public:
+    /**
+     * @brief Construct a new autopilot, with a simulation of the level for
+     * each thread.
+     *
+     * @param levelName the level of the games played by the autopilot
+     * @param options
+     */
+    mcts(const std::string &levelName, const MctsOptions &options);
+    ~mcts();
+    /**
+     * @brief Choose the input of the next step of a game.
+     *
+     * @param Sim the game, its state is not changed
+     * @return dir NONE while pacman is not at the center of a square, to keep
+     * the direction
+     */
+    dir play(simulation &Sim);
+    /**
+     * @brief Get the number of rollouts played for the last direction.
+     *
+     * @return size_t
+     */
+    size_t getIterations() const;
+
+  private:
+    /**
+     * @brief Simulation and search tree of a thread.
+     */
+    struct worker {
+        std::unique_ptr<simulation> Sim;
+        std::vector<MctsNode> tree;
+        // nodes of the current rollout, from the root
+        std::vector<uint32_t> path;
+        rng random;
+        size_t iterations;
+    };
+    /**
+     * @brief Search from the root until the time or the iterations are
+     * spent.
+     *
+     * @param Worker
+     * @param iterations maximum number of rollouts, 0 for no limit
+     */
+    void search(worker &Worker, size_t iterations);
+    /**
+     * @brief Play a rollout from the root: go down the tree, expand it and
+     * play random moves.
+     *
+     * @param Worker
+     */
+    void iterate(worker &Worker);
+
+    MctsOptions _options;
+    std::vector<std::unique_ptr<worker>> _workers;
+    GameSnapshot _root;
+    size_t _rootScore;
+    std::chrono::steady_clock::time_point _deadline;
+    size_t _iterations;
+};
+
+#endif
@@ -2,10 +2,9 @@
 #define PACMAN_H
 
 #include "fruit.h"
-#include "ghost.h"
+#include "ghostpack.h"
+#include "pellets.h"
 
-#define PACMAN_INIT_X 10
-#define PACMAN_INIT_Y 20
 #define PACMAN_CENTER_X 0
 #define PACMAN_CENTER_Y 4
 
@@ -26,7 +25,13 @@
 
 class pacman {
   public:
-    pacman();
+    /**
+     * @brief Construct a new pacman.
+     *
+     * @param clock the clock of the game
+     * @param Level the level giving the spawn and the tunnels
+     */
+    pacman(const gameClock &clock, const level &Level);
     ~pacman();
     /**
      * @brief Init pacman.
@@ -44,12 +49,26 @@ class pacman {
      * @return std::pair<size_t, size_t>
      */
     std::pair<size_t, size_t> getPos();
+    /**
+     * @brief Get the square where pacman is, or where he goes when he moves.
+     *
+     * @return std::pair<size_t, size_t>
+     */
+    std::pair<size_t, size_t> getSquare() const;
     /**
      * @brief Update the sprite position of pacman.
      *
      * @note The sprite position represents the pixel position of pacman.
      */
     void updatePos();
+    /**
+     * @brief Check if pacman reaches the center of a square at the next tick,
+     * where he can change of direction, without moving his sprite.
+     *
+     * @return true
+     * @return false
+     */
+    bool isAtSquareCenter() const;
     /**
      * @brief Wait for pacman to be in the center of a square in function of
      * his direction and his sprite position.
@@ -66,8 +85,7 @@ class pacman {
      * @param vecBoard
      * @param currentDir
      */
-    void updateDir(std::vector<std::vector<std::shared_ptr<square>>> vecBoard,
-                   dir currentDir);
+    void updateDir(gridView vecBoard, dir currentDir);
     /**
      * @brief Get the last direction of pacman.
      *
@@ -79,16 +97,16 @@ class pacman {
      * Update the square and the score if pacman eats a dot or a powerup.
      *
      * @param vecBoard
+     * @param Ghosts
+     * @param Fruit
      */
-    void
-    updateSquare(std::vector<std::vector<std::shared_ptr<square>>> vecBoard,
-                 std::vector<std::shared_ptr<ghost>> vecGhost, fruit *Fruit);
+    void updateSquare(gridView vecBoard, ghostPack &Ghosts, fruit *Fruit);
     /**
      * @brief Set the powerup of pacman.
      *
      * @param powerup
      */
-    time_t getPowerupTimer();
+    tick_t getPowerupTimer();
     /**
      * @brief Set the powerup of pacman.
      *
@@ -107,11 +125,11 @@ class pacman {
      * If pacman is in collision with a ghost, the ghost is eaten if
      * pacman is in powerup mode, else pacman is eaten.
      *
-     * @param vecGhost
+     * @param Ghosts
      * @return true
      * @return false
      */
-    bool ghostCollision(std::vector<std::shared_ptr<ghost>> vecGhost);
+    bool ghostCollision(ghostPack &Ghosts);
     /**
      * @brief Get the color of the ghost eaten by pacman.
      * @return color
@@ -127,7 +145,7 @@ class pacman {
      * @brief Get the Fruit Eaten object.
      *
      */
-    std::vector<typeFruit> getEatenFruit();
+    const std::vector<typeFruit> &getEatenFruit();
     /**
      * @brief Get the Fruit Eaten object.
      *
@@ -137,15 +155,9 @@ class pacman {
     /**
      * @brief Get the fruit eaten timer object.
      *
-     * @return time_t
+     * @return tick_t
      */
-    time_t getfruitEatenTimer();
-    /**
-     * @brief Set the fruit eaten score object.
-     *
-     * @param score
-     */
-    void setFruitEatenScore(short score);
+    tick_t getfruitEatenTimer();
     /**
      * @brief Get the score of fruit eaten by pacman.
      *
@@ -188,20 +200,42 @@ class pacman {
     /**
      * @brief Get the no eaten dot timer object.
      *
-     * @return time_t
+     * @return tick_t
+     */
+    tick_t getNoEatenDotTimer();
+    /**
+     * @brief Save the state of pacman.
+     *
+     * @param state
+     * @return true
+     * @return false if more than SNAPSHOT_MAX_FRUITS fruits were eaten
+     */
+    bool save(PacmanState &state) const;
+    /**
+     * @brief Restore a state saved by save().
+     *
+     * @param state
+     */
+    void restore(const PacmanState &state);
+    /**
+     * @brief Get the key of pacman in the hash of the game.
+     *
+     * @return uint64_t
      */
-    time_t getNoEatenDotTimer();
+    uint64_t getHash() const;
 
   private:
     // board coordinates corresponding to coordinates of the board vector
     // pixel coordinates corresponding to the sprite position
     size_t _xBoard, _yBoard, _xPixel, _yPixel;
+    const gameClock *_clock;
+    const level *_level;
     dir _lastDir, _oldDir;
     size_t _score;
     size_t _dotCounter;
     size_t _dotCounterLevel;
     bool _powerup;
-    time_t powerupTimer1;
+    tick_t powerupTimer1;
     // ghostEaten is the number of ghost eaten in a level
     // ghostEatenScore is the score of the ghost eaten with one powerup
     short _ghostEaten, _ghostEatenScore;
@@ -210,10 +244,10 @@ class pacman {
     // fruitEatenScore is the score of the fruit eaten
     std::vector<typeFruit> _eatenFruit;
     short _fruitEaten, _fruitEatenScore;
-    time_t fruitEatenTimer1;
+    tick_t fruitEatenTimer1;
     short _remainingLife;
     // timer since the last dot eaten by pacman
-    time_t noEatenDotTimer1;
+    tick_t noEatenDotTimer1;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,131 @@
+#ifndef PACMAN_ENV_H
+#define PACMAN_ENV_H
+
+/*
+ * C API of the game for reinforcement learning, built as the shared library
+ * bin/libpacman_env.so by "make env". A pacman_env plays N independent games
+ * in lockstep: each step plays one tick of every game with the action given
+ * for it, then writes the observations, the rewards and the ends of games in
+ * buffers given by the caller. A game which ends is started again at once
+ * with the next seed, the observation written is the first one of the new
+ * game. Nothing is allocated after pacman_env_create.
+ *
+ * The observation of a game is a block of uint8_t planes of height x width
+ * squares, row after row:
+ *   PACMAN_ENV_PLANE_WALLS     1 on the walls and the door of the house
+ *   PACMAN_ENV_PLANE_DOTS      1 on the dots
+ *   PACMAN_ENV_PLANE_POWERUPS  1 on the powerups
+ *   PACMAN_ENV_PLANE_PACMAN    1 on the square of pacman
+ *   PACMAN_ENV_PLANE_GHOSTS+i  the mode of the ghost i on its square (a
+ *                              PACMAN_ENV_GHOST_* value), 0 elsewhere
+ * The observations of the games follow each other in the buffer.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define PACMAN_ENV_VERSION 1
+
+#if defined(__GNUC__)
+#define PACMAN_ENV_API __attribute__((visibility("default")))
+#else
+#define PACMAN_ENV_API
+#endif
+
+/* actions, the directions of the game */
+#define PACMAN_ENV_LEFT 0
+#define PACMAN_ENV_RIGHT 1
+#define PACMAN_ENV_UP 2
+#define PACMAN_ENV_DOWN 3
+#define PACMAN_ENV_NOOP 4 /* keep the last direction */
+
+/* planes of an observation */
+#define PACMAN_ENV_PLANE_WALLS 0
+#define PACMAN_ENV_PLANE_DOTS 1
+#define PACMAN_ENV_PLANE_POWERUPS 2
+#define PACMAN_ENV_PLANE_PACMAN 3
+#define PACMAN_ENV_PLANE_GHOSTS 4
+
+/* values of the planes of the ghosts */
+#define PACMAN_ENV_GHOST_DANGER 1     /* chases or scatters */
+#define PACMAN_ENV_GHOST_FRIGHTENED 2 /* can be eaten */
+#define PACMAN_ENV_GHOST_EYES 3       /* eaten, goes back to the house */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct pacman_env pacman_env;
+
+/**
+ * @brief Create the games on the classic maze, played on all the cores.
+ *
+ * @param n_envs number of games
+ * @param seed the game i is played with the seed seed + i, its next games
+ * with seed + i + n_envs, seed + i + 2 * n_envs...
+ * @return pacman_env* NULL if the games can not be created
+ */
+PACMAN_ENV_API pacman_env *pacman_env_create(size_t n_envs, uint64_t seed);
+/**
+ * @brief Create the games on a level.
+ *
+ * @param level a text board or a compiled level file
+ * @param n_envs number of games
+ * @param seed as for pacman_env_create
+ * @param n_threads threads which play the games, 0 for all the cores
+ * @return pacman_env* NULL if the level can not be read
+ */
+PACMAN_ENV_API pacman_env *pacman_env_create_level(const char *level,
+                                                   size_t n_envs,
+                                                   uint64_t seed,
+                                                   size_t n_threads);
+/**
+ * @brief Destroy the games.
+ *
+ * @param env
+ */
+PACMAN_ENV_API void pacman_env_destroy(pacman_env *env);
+/**
+ * @brief Get the number of games.
+ *
+ * @param env
+ * @return size_t
+ */
+PACMAN_ENV_API size_t pacman_env_num_envs(const pacman_env *env);
+/**
+ * @brief Get the shape of the observation of a game.
+ *
+ * @param env
+ * @param planes PACMAN_ENV_PLANE_GHOSTS + the number of ghosts
+ * @param height
+ * @param width
+ */
+PACMAN_ENV_API void pacman_env_obs_shape(const pacman_env *env,
+                                         size_t *planes, size_t *height,
+                                         size_t *width);
+/**
+ * @brief Start a new game in each environment, with their next seed.
+ *
+ * @param env
+ * @param obs n_envs observations
+ */
+PACMAN_ENV_API void pacman_env_reset(pacman_env *env, uint8_t *obs);
+/**
+ * @brief Play one tick of each game.
+ *
+ * @param env
+ * @param actions n_envs PACMAN_ENV_* actions, the others are PACMAN_ENV_NOOP
+ * @param obs n_envs observations after the tick
+ * @param rewards n_envs points scored during the tick
+ * @param dones n_envs, 1 if the game is over (the observation is then the
+ * one of the next game)
+ */
+PACMAN_ENV_API void pacman_env_step(pacman_env *env, const int32_t *actions,
+                                    uint8_t *obs, float *rewards,
+                                    uint8_t *dones);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,143 @@
+#ifndef PATHTABLE_H
+#define PATHTABLE_H
+
+#include "grid.h"
+
+#define PATH_TABLE_EXTENSION ".path"
+#define PATH_TABLE_MAX_CELLS 4096 // 48MB of tables
+#define PATH_TABLE_MAGIC 0x54504d50 // "PMPT"
+#define PATH_TABLE_VERSION 1
+
+#define UNREACHABLE 0xffff
+
+/**
+ * @brief Distances and first moves between all the pairs of squares of the
+ * board, computed once with a BFS from each square which is not a wall.
+ *
+ * @note Door squares are crossed like halls (as for findShortestPath) and a
+ * line whose both border squares are not walls is a tunnel linking them.
+ */
+class pathTable {
+  public:
+    pathTable();
+    ~pathTable();
+    /**
+     * @brief Compute the tables for the board.
+     *
+     * @param vecBoard
+     */
+    void build(gridView vecBoard);
+    /**
+     * @brief Load the tables from a file.
+     *
+     * @param fileName
+     * @param vecBoard the board the tables must correspond to
+     * @return true if the file exists and matches the board
+     * @return false
+     */
+    bool load(const std::string &fileName, gridView vecBoard);
+    /**
+     * @brief Save the tables in a file.
+     *
+     * @param fileName
+     * @return true
+     * @return false
+     */
+    bool save(const std::string &fileName);
+    /**
+     * @brief Check if the tables are computed.
+     *
+     * @return true
+     * @return false
+     */
+    bool isBuilt() const;
+    /**
+     * @brief Check if the tables are computed for a board.
+     *
+     * @param vecBoard
+     * @return true
+     * @return false
+     */
+    bool matches(gridView vecBoard) const;
+    /**
+     * @brief Get the length of the shortest path between two squares.
+     *
+     * @param xStart
+     * @param yStart
+     * @param xEnd
+     * @param yEnd
+     * @return int -1 if there is no path
+     */
+    int getDistance(size_t xStart, size_t yStart, size_t xEnd,
+                    size_t yEnd) const;
+    /**
+     * @brief Get the first direction to take to go from a square to another
+     * with the shortest path.
+     *
+     * @param xStart
+     * @param yStart
+     * @param xEnd
+     * @param yEnd
+     * @return dir NONE if there is no path or if both squares are the same
+     */
+    dir getNextDir(size_t xStart, size_t yStart, size_t xEnd,
+                   size_t yEnd) const;
+    /**
+     * @brief Get the first direction to take to go from a square to another
+     * with the shortest path without going back.
+     *
+     * @param xStart
+     * @param yStart
+     * @param xEnd
+     * @param yEnd
+     * @param lastDir the direction of the last move, its opposite is avoided
+     * @return dir NONE if there is no path or if both squares are the same
+     */
+    dir getNextDir(size_t xStart, size_t yStart, size_t xEnd, size_t yEnd,
+                   dir lastDir) const;
+
+  private:
+    /**
+     * @brief Give an id to each square of the board which is not a wall.
+     *
+     * @param vecBoard
+     */
+    void indexCells(gridView vecBoard);
+    /**
+     * @brief Get the cell id of the square reached from a square in a
+     * direction, taking the tunnels.
+     *
+     * @param x
+     * @param y
+     * @param d
+     * @return int -1 if the square is a wall or outside the board
+     */
+    int getNeighbor(size_t x, size_t y, dir d) const;
+    /**
+     * @brief Get the cell id of a square.
+     *
+     * @param x
+     * @param y
+     * @return int -1 if the square is a wall or outside the board
+     */
+    int getCell(size_t x, size_t y) const;
+    /**
+     * @brief Compute a checksum of the states of the board.
+     *
+     * @param vecBoard
+     * @return uint64_t
+     */
+    static uint64_t checksum(gridView vecBoard);
+
+    size_t _width, _height, _nbCells;
+    uint64_t _checksum;
+    // cell id of each square, -1 for the walls
+    std::vector<int> _cell;
+    // coordinates of each cell
+    std::vector<Coordinate> _coord;
+    // tables indexed by start cell * _nbCells + end cell
+    std::vector<uint16_t> _distance;
+    std::vector<uint8_t> _nextDir;
+};
+
+#endif
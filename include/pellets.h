@@ -0,0 +1,111 @@
+#ifndef PELLETS_H
+#define PELLETS_H
+
+#include "bitboard.h"
+#include "zobrist.h"
+
+/**
+ * @brief Set of the dots and powerups remaining on the board.
+ *
+ * @note Each kind of item is kept in a dense list, so that it can be drawn
+ * without scanning the board, and in the bitboard of the board. The slot of
+ * each square in its list allows to remove an item in constant time by moving
+ * the last item of the list in its place. The tracker is updated by the
+ * gameplay through the board view each time an item is eaten, and keeps the
+ * Zobrist hash of the items up to date: the xor of the key of each item.
+ */
+class pelletTracker {
+  public:
+    pelletTracker();
+    ~pelletTracker();
+    /**
+     * @brief Collect the dots and powerups of the board and build its
+     * bitboard.
+     *
+     * @param vecBoard
+     */
+    void build(gridView vecBoard);
+    /**
+     * @brief Check if the tracker is built.
+     *
+     * @return true
+     * @return false
+     */
+    bool isBuilt() const { return !_slot.empty(); }
+    /**
+     * @brief Add an item on a square.
+     *
+     * @param x
+     * @param y
+     * @param item _DOT or _POWERUP, the other items are ignored
+     */
+    void add(size_t x, size_t y, typeItem item);
+    /**
+     * @brief Remove the item of a square.
+     *
+     * @param x
+     * @param y
+     */
+    void remove(size_t x, size_t y);
+    /**
+     * @brief Check if a dot or a powerup is on a square.
+     *
+     * @param x
+     * @param y
+     * @return true
+     * @return false
+     */
+    bool isPellet(size_t x, size_t y) const {
+        return _bits.test(LAYER_DOT, x, y) || _bits.test(LAYER_POWERUP, x, y);
+    }
+    /**
+     * @brief Get the number of remaining dots.
+     *
+     * @return size_t
+     */
+    size_t getDotCount() const { return _vecDot.size(); }
+    /**
+     * @brief Get the number of remaining powerups.
+     *
+     * @return size_t
+     */
+    size_t getPowerupCount() const { return _vecPowerup.size(); }
+    /**
+     * @brief Get the position of the remaining dots, in no particular order.
+     *
+     * @return const std::vector<Coordinate>&
+     */
+    const std::vector<Coordinate> &getDotList() const { return _vecDot; }
+    /**
+     * @brief Get the position of the remaining powerups, in no particular
+     * order.
+     *
+     * @return const std::vector<Coordinate>&
+     */
+    const std::vector<Coordinate> &getPowerupList() const {
+        return _vecPowerup;
+    }
+    /**
+     * @brief Get the bitboard of the board.
+     *
+     * @return bitboard&
+     */
+    bitboard &getBits() { return _bits; }
+    const bitboard &getBits() const { return _bits; }
+    /**
+     * @brief Get the hash of the remaining items.
+     *
+     * @return uint64_t
+     */
+    uint64_t getHash() const { return _hash; }
+
+  private:
+    size_t _width, _height;
+    bitboard _bits;
+    // index of the item of each square in its list, -1 if there is none
+    std::vector<int> _slot;
+    std::vector<Coordinate> _vecDot, _vecPowerup;
+    uint64_t _hash;
+};
+
+#endif
@@ -0,0 +1,154 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "simulation.h"
+
+#define REPLAY_MAGIC 0x50524d50 // "PMRP"
+#define REPLAY_VERSION 2
+#define REPLAY_CHECK_STEPS 1000 // steps between two hashes of the game
+#define REPLAY_MAX_GHOSTS 65536 // more ghosts are a corrupt file
+
+/**
+ * @brief Header of a replay file. It is followed by the name of the level,
+ * the commit of the build which recorded the game, the stream of the changes
+ * of direction and the hashes of the game every REPLAY_CHECK_STEPS steps.
+ * The header of the first version ends before the hash.
+ */
+struct ReplayHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t seed;
+    uint64_t levelHash;
+    uint64_t steps; // number of calls to simulation::step
+    uint64_t score; // score at the end of the recording
+    uint32_t nbGhosts;
+    uint32_t level; // level at the end of the recording
+    uint32_t nbChanges;
+    uint32_t levelNameLength;
+    uint32_t buildLength;
+    uint32_t streamLength;
+    uint64_t hash; // hash of the game at the end of the recording
+    uint32_t nbChecks;
+    uint32_t padding;
+};
+
+/**
+ * @brief Result of a game played again from a replay.
+ */
+struct ReplayResult {
+    size_t score;
+    int level;
+    int deaths;
+    tick_t ticks;
+    // first step where the hash of the game differs from the recorded one,
+    // REPLAY_NO_DIVERGENCE if the game is the same
+    uint64_t divergence;
+};
+
+#define REPLAY_NO_DIVERGENCE UINT64_MAX
+
+/**
+ * @brief A replay records the input given to the simulation at each step of
+ * a game, so that the game can be played again exactly without display.
+ *
+ * @note The game only depends on its seed, its level, its number of ghosts
+ * and the input of each step. The input is kept as the list of its changes,
+ * each one written as a varint of the number of steps since the previous
+ * change and of the new direction, which takes 1 or 2 bytes. The lives are
+ * started again after a death or a cleared level, as the game does, and the
+ * replay ends with the game or when the player left it. The hash of the game
+ * is kept every REPLAY_CHECK_STEPS steps, so that a build which plays the
+ * game in another way is found at the first step which differs.
+ */
+class replay {
+  public:
+    replay();
+    /**
+     * @brief Start the recording of the game which is about to begin.
+     *
+     * @param Sim the simulation, with its seed and its number of ghosts
+     * @param levelName the file of the level loaded in the simulation
+     */
+    void start(simulation &Sim, const std::string &levelName);
+    /**
+     * @brief Record the input given to the next step.
+     *
+     * @param input
+     * @param Sim the simulation, hashed before some of the steps
+     */
+    void record(dir input, simulation &Sim);
+    /**
+     * @brief Keep the score and the level at the end of the recording, to
+     * check them when the game is played again.
+     *
+     * @param Sim
+     */
+    void finish(simulation &Sim);
+    /**
+     * @brief Check if a game was recorded or loaded.
+     *
+     * @return true
+     * @return false
+     */
+    bool isStarted() const { return _header.magic == REPLAY_MAGIC; }
+    /**
+     * @brief Save the replay in a file.
+     *
+     * @param fileName
+     * @return true
+     * @return false
+     */
+    bool save(const std::string &fileName) const;
+    /**
+     * @brief Load a replay file.
+     *
+     * @param fileName
+     * @return true
+     * @return false if the file is missing or invalid
+     */
+    bool load(const std::string &fileName);
+    /**
+     * @brief Play the game again, as fast as possible.
+     *
+     * @param Sim a simulation where the level of the replay is loaded
+     * @return ReplayResult
+     */
+    ReplayResult play(simulation &Sim) const;
+    /**
+     * @brief Get the header, with the seed and the recorded results.
+     *
+     * @return const ReplayHeader&
+     */
+    const ReplayHeader &getHeader() const { return _header; }
+    /**
+     * @brief Get the file of the level.
+     *
+     * @return const std::string&
+     */
+    const std::string &getLevelName() const { return _levelName; }
+    /**
+     * @brief Get the commit of the build which recorded the game.
+     *
+     * @return const std::string&
+     */
+    const std::string &getBuild() const { return _build; }
+    /**
+     * @brief Get the commit of this build.
+     *
+     * @return const char*
+     */
+    static const char *currentBuild();
+
+  private:
+    ReplayHeader _header;
+    std::string _levelName, _build;
+    // encoded changes of direction
+    std::vector<uint8_t> _stream;
+    // hash of the game before the steps multiple of REPLAY_CHECK_STEPS
+    std::vector<uint64_t> _checks;
+    // last input recorded and step of its change
+    dir _lastInput;
+    uint64_t _lastChange;
+};
+
+#endif
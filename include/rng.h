@@ -0,0 +1,78 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <cstdint>
+
+#define DEFAULT_SEED 0x853c49e6748fea9bULL
+
+#define PCG_MULTIPLIER 6364136223846793005ULL
+#define PCG_INCREMENT 1442695040888963407ULL
+
+/**
+ * @brief Small random number generator (PCG32) owned by the game, so that a
+ * game can be replayed exactly from its seed.
+ */
+class rng {
+  public:
+    /**
+     * @brief Construct a new random number generator.
+     *
+     * @param seed
+     */
+    explicit rng(uint64_t seed = DEFAULT_SEED) { setSeed(seed); }
+    /**
+     * @brief Restart the sequence of numbers from a seed.
+     *
+     * @param seed
+     */
+    void setSeed(uint64_t seed) {
+        _state = 0;
+        next();
+        _state += seed;
+        next();
+    }
+    /**
+     * @brief Get the next random number.
+     *
+     * @return uint32_t
+     */
+    uint32_t next() {
+        uint64_t old = _state;
+        _state = old * PCG_MULTIPLIER + PCG_INCREMENT;
+        uint32_t xorShifted = uint32_t(((old >> 18u) ^ old) >> 27u);
+        uint32_t rot = uint32_t(old >> 59u);
+        return (xorShifted >> rot) | (xorShifted << ((-rot) & 31));
+    }
+    /**
+     * @brief Get a random number uniformly distributed in [0, bound[.
+     *
+     * @param bound must not be 0
+     * @return uint32_t
+     */
+    uint32_t bounded(uint32_t bound) {
+        // reject the numbers which would make the low values more frequent
+        uint32_t threshold = -bound % bound;
+        for (;;) {
+            uint32_t r = next();
+            if (r >= threshold)
+                return r % bound;
+        }
+    }
+    /**
+     * @brief Get the state of the generator, to continue its sequence later.
+     *
+     * @return uint64_t
+     */
+    uint64_t getState() const { return _state; }
+    /**
+     * @brief Continue the sequence from a state given by getState().
+     *
+     * @param state
+     */
+    void setState(uint64_t state) { _state = state; }
+
+  private:
+    uint64_t _state;
+};
+
+#endif
@@ -2,48 +2,76 @@
 #define SHORTESTPATH_H
 
 #include "lib.h"
-#include "square.h"
+#include "bitboard.h"
 #include <algorithm>
-#include <set>
 
 #define CONVERGENCE 50
 
+#define MAX_BLOCKED_SQUARES 4
+
 struct Node {
     size_t x;
     size_t y;
     int distance;
-    std::shared_ptr<Node> parent;
+};
+
+/**
+ * @brief Squares considered as walls by the pathfinding, on top of the walls
+ * of the board, so that the board does not have to be copied.
+ */
+struct BlockedSquares {
+    size_t size;
+    Coordinate squares[MAX_BLOCKED_SQUARES];
 };
 
 /**
  * @brief Find the shortest path between two positions using A* algorithm with
  * Manhattan Heuristic.
  *
+ * @note The open set is a binary heap ordered by f score and the closed set,
+ * the distances and the parents are arrays indexed by cell, so a query does not
+ * allocate anything else than the returned path.
+ *
  * @param vecBoard
  * @param xStart
  * @param yStart
  * @param xEnd
  * @param yEnd
- * @return std::vector<std::shared_ptr<Node>>
+ * @return std::vector<Node> the path from the start to the end, both included
  */
 
-std::vector<std::shared_ptr<Node>>
-findShortestPath(std::vector<std::vector<std::shared_ptr<square>>> vecBoard,
-                 size_t xStart, size_t yStart, size_t xEnd, size_t yEnd);
+std::vector<Node> findShortestPath(gridView vecBoard, size_t xStart,
+                                   size_t yStart, size_t xEnd, size_t yEnd);
+
+/**
+ * @brief Find the shortest path between two positions like findShortestPath,
+ * the blocked squares being considered as walls.
+ *
+ * @param vecBoard
+ * @param blocked
+ * @param xStart
+ * @param yStart
+ * @param xEnd
+ * @param yEnd
+ * @return std::vector<Node>
+ */
+std::vector<Node> findShortestPath(gridView vecBoard,
+                                   const BlockedSquares &blocked,
+                                   size_t xStart, size_t yStart, size_t xEnd,
+                                   size_t yEnd);
 
 /**
- * @brief Make a new vecBoard without the possibility to go back for the
- * calculation of the shortest path.
+ * @brief Block the square behind a character to remove the possibility to go
+ * back for the calculation of the shortest path.
  *
  * @param vecBoard
  * @param _lastDir
  * @param _xBoard
  * @param _yBoard
- * @return std::vector<std::vector<std::shared_ptr<square>>>
+ * @return BlockedSquares
  */
-std::vector<std::vector<std::shared_ptr<square>>>
-removeAboutTurn(std::vector<std::vector<std::shared_ptr<square>>> vecBoard,
-                dir _lastDir, size_t _xBoard, size_t _yBoard);
+BlockedSquares removeAboutTurn(gridView vecBoard, dir _lastDir,
+                               size_t _xBoard, size_t _yBoard);
 
 /**
  * @brief Find the direction to take to go from A to B.
@@ -52,20 +80,23 @@ removeAboutTurn(std::vector<std::vector<std::shared_ptr<square>>> vecBoard,
  * @param B
  * @return dir
  */
-dir findDir(std::shared_ptr<Node> A, std::shared_ptr<Node> B);
+dir findDir(const Node &A, const Node &B);
 
 /**
  * @brief Find the possible directions caracter can take with avoiding a
  * special direction and avoid going back.
  *
+ * @note A mask instead of a list, so that the ghosts which turn at random
+ * do not allocate.
+ *
  * @param vecBoard
  * @param lastDir
  * @param avoidDir
  * @param x
  * @param y
+ * @return unsigned DIR_MASK of each possible direction
  */
-std::vector<dir>
-findPossibleDir(std::vector<std::vector<std::shared_ptr<square>>> vecBoard,
-                dir lastDir, dir avoidDir, size_t x, size_t y);
+unsigned findPossibleDir(gridView vecBoard, dir lastDir, dir avoidDir,
+                         size_t x, size_t y);
 
 #endif
\ No newline at end of file
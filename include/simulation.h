@@ -0,0 +1,217 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include "board.h"
+
+#define NB_GHOSTS 4
+
+enum stepResult { STEP_WAIT, STEP_PLAY, STEP_LEVEL_CLEARED, STEP_DEATH,
+                  STEP_GAME_OVER };
+
+/**
+ * @brief The simulation owns the board, pacman, the ghosts and the fruit and
+ * applies the rules of the game tick by tick, without any display. The clock
+ * of the game only moves when a tick is played.
+ *
+ * @note After a STEP_LEVEL_CLEARED or a STEP_DEATH, the caller has to call
+ * startLife() before the next step, so that it can display the state at the
+ * end of the life first (the life is only removed by startLife()). After a
+ * STEP_GAME_OVER, it has to call newGame() and startLife().
+ */
+class simulation {
+  public:
+    /**
+     * @brief Construct a new simulation.
+     *
+     * @param seed the seed of the random decisions of the ghosts
+     */
+    explicit simulation(uint64_t seed = DEFAULT_SEED);
+    ~simulation();
+    /**
+     * @brief Load the board and its path tables.
+     *
+     * @param fileName a text board or a compiled level file
+     * @param paths the path tables of another simulation of the same level,
+     * to share them, nullptr to load them
+     */
+    void load(const std::string &fileName = LEVEL_FILE,
+              std::shared_ptr<const pathTable> paths = nullptr);
+    /**
+     * @brief Reset the score, the lives, the level and the random number
+     * generator for a new game.
+     */
+    void newGame();
+    /**
+     * @brief Place pacman and the ghosts at their initial position, and
+     * reload the items if the level was cleared.
+     */
+    void startLife();
+    /**
+     * @brief Play one tick of the game.
+     *
+     * @param input the direction pressed by the player, NONE if no direction
+     * is pressed
+     * @return stepResult STEP_WAIT while no direction has been pressed since
+     * the beginning of the life
+     */
+    stepResult step(dir input);
+    /**
+     * @brief Check if the player has pressed a direction since the beginning
+     * of the life.
+     *
+     * @return true
+     * @return false
+     */
+    bool isStarted();
+    /**
+     * @brief Get the current level.
+     *
+     * @return int
+     */
+    int getLevel();
+    /**
+     * @brief Change the seed used by the next games.
+     *
+     * @param seed
+     */
+    void setSeed(uint64_t seed);
+    /**
+     * @brief Change the number of ghosts of the next lives.
+     *
+     * @param nbGhosts
+     */
+    void setNbGhosts(size_t nbGhosts);
+    /**
+     * @brief Get the number of ghosts of the next lives.
+     *
+     * @return size_t
+     */
+    size_t getNbGhosts();
+    /**
+     * @brief Get the seed of the games.
+     *
+     * @return uint64_t
+     */
+    uint64_t getSeed();
+    /**
+     * @brief Get the clock of the game.
+     *
+     * @return const gameClock&
+     */
+    const gameClock &getClock();
+    /**
+     * @brief Get the board.
+     *
+     * @return board&
+     */
+    board &getBoard();
+    /**
+     * @brief Get pacman.
+     *
+     * @return pacman&
+     */
+    pacman &getPacman();
+    /**
+     * @brief Get the ghosts.
+     *
+     * @return ghostPack&
+     */
+    ghostPack &getGhosts();
+    /**
+     * @brief Get the fruit.
+     *
+     * @return fruit&
+     */
+    fruit &getFruit();
+    /**
+     * @brief Get the list of the dot's position after the last tick.
+     *
+     * @return const std::vector<Coordinate>&
+     */
+    const std::vector<Coordinate> &getDotList();
+    /**
+     * @brief Get the list of the powerup's position after the last tick.
+     *
+     * @return const std::vector<Coordinate>&
+     */
+    const std::vector<Coordinate> &getPowerupList();
+    /**
+     * @brief Get the bitboard of the board, with pacman and the ghosts after
+     * the last tick.
+     *
+     * @return const bitboard&
+     */
+    const bitboard &getBits();
+    /**
+     * @brief Save the whole state of the game.
+     *
+     * @param snapshot
+     * @return true
+     * @return false if the game does not fit in a snapshot: more than
+     * SNAPSHOT_MAX_GHOSTS ghosts, a maze of more than 64x64 squares or more
+     * than SNAPSHOT_MAX_FRUITS fruits eaten
+     */
+    bool save(GameSnapshot &snapshot);
+    /**
+     * @brief Go back to a state saved by save(), the next steps play as they
+     * were played after the save.
+     *
+     * @param snapshot
+     * @return true
+     * @return false if the snapshot was saved on another level or is not
+     * valid (see checkSnapshot)
+     */
+    bool restore(const GameSnapshot &snapshot);
+    /**
+     * @brief Get the Zobrist hash of the state of the game, equal for two
+     * games in the same state whatever the way they reached it.
+     *
+     * @note The items of the board, the only part as large as the maze, are
+     * hashed as they are eaten and put back. Pacman, each ghost, the fruit
+     * and the state of the simulation (clock, random generator, level) have
+     * a key of their own, computed from their fields when the hash is read.
+     *
+     * @return uint64_t
+     */
+    uint64_t getHash();
+    /**
+     * @brief Compute the hash again with the items read on the board, it is
+     * compared to getHash() after each step in debug builds.
+     *
+     * @return uint64_t
+     */
+    uint64_t computeHash();
+
+  private:
+    /**
+     * @brief Get the key of the state of the simulation in the hash.
+     *
+     * @return uint64_t
+     */
+    uint64_t getGameHash();
+    /**
+     * @brief Leave if the hash kept up to date differs from the one computed
+     * again.
+     */
+    void checkHash();
+
+    // the clock is declared first as pacman, the ghosts and the fruit keep a
+    // reference
+    gameClock _clock;
+    uint64_t _seed;
+    // hash of the level, to check the snapshots
+    uint64_t _levelHash;
+    rng _rng;
+    board _board;
+    pacman _pacman;
+    ghostPack _ghosts;
+    size_t _nbGhosts;
+    fruit _fruit;
+    int _level;
+    bool _nextLevel, _start, _death;
+    // the actor layers of the bitboard are only updated when read
+    bool _actorsChanged;
+    dir _currentDir;
+};
+
+#endif
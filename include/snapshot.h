@@ -0,0 +1,115 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "gameclock.h"
+#include <string>
+#include <type_traits>
+
+#define SNAPSHOT_MAGIC 0x534d5050 // "PPMS"
+#define SNAPSHOT_VERSION 1
+
+#define SNAPSHOT_MAX_GHOSTS 8
+#define SNAPSHOT_MAX_ROWS 64   // one word of pellets per line of the maze
+#define SNAPSHOT_MAX_FRUITS 64 // fruits eaten during a game
+
+/**
+ * @brief State of pacman in a snapshot.
+ */
+struct PacmanState {
+    uint64_t xBoard, yBoard, xPixel, yPixel;
+    uint64_t score, dotCounter, dotCounterLevel;
+    uint64_t powerupTimer, fruitEatenTimer, noEatenDotTimer;
+    int16_t ghostEaten, ghostEatenScore, fruitEaten, fruitEatenScore;
+    int16_t remainingLife;
+    uint8_t lastDir, oldDir, powerup, ghostEatenColor, nbEatenFruits;
+    uint8_t padding;
+    uint8_t eatenFruit[SNAPSHOT_MAX_FRUITS];
+};
+
+/**
+ * @brief State of a ghost in a snapshot, with its position in the pack.
+ */
+struct GhostState {
+    uint64_t xBoard, yBoard, xPixel, yPixel, xPixelEaten, yPixelEaten;
+    uint64_t modeTimer, blueTimer;
+    int32_t swapMode;
+    uint8_t color, lastDir, mode, scatterDir;
+    uint8_t scatterHouse, chaseMode, scatterMode, frightenedMode;
+    uint8_t isTime, isInHouse, isReturnHouse, isFear, isInTunnel;
+    uint8_t blueRed, bluePink;
+    // result of the last waitSquareCenter() and findContact() of the pack
+    uint8_t atCenter, contact;
+    uint8_t padding[3];
+};
+
+/**
+ * @brief State of the fruit in a snapshot.
+ */
+struct FruitState {
+    uint64_t timer;
+    int32_t lastFruit;
+    uint8_t fruit;
+    uint8_t padding[3];
+};
+
+/**
+ * @brief Whole state of a game, as saved by simulation::save.
+ *
+ * @note The snapshot is a plain structure of fixed size, copied with memcpy
+ * and written as is in a file, without any pointer: the ghosts are kept in an
+ * array of SNAPSHOT_MAX_GHOSTS states and the dots and the powerups in one
+ * word per line of the maze, so only the mazes of at most 64x64 squares can
+ * be saved. The fields have a fixed size and the padding is explicit, so that
+ * the files do not depend on the compiler (they are written in the byte
+ * order of the machine, as the compiled levels).
+ */
+struct GameSnapshot {
+    uint32_t magic, version;
+    uint64_t levelHash;
+    uint64_t tick, seed, rngState;
+    uint32_t width, height, nbGhosts;
+    int32_t level;
+    uint8_t nextLevel, start, death, currentDir;
+    uint8_t padding[4];
+    PacmanState pacman;
+    FruitState fruit;
+    GhostState ghosts[SNAPSHOT_MAX_GHOSTS];
+    // remaining items, bit x of the word y for the square (x, y)
+    uint64_t dots[SNAPSHOT_MAX_ROWS], powerups[SNAPSHOT_MAX_ROWS];
+};
+
+static_assert(std::is_trivially_copyable<GameSnapshot>::value,
+              "a snapshot must be copied with memcpy");
+static_assert(sizeof(PacmanState) == 160 && sizeof(GhostState) == 88 &&
+                  sizeof(FruitState) == 16 && sizeof(GameSnapshot) == 1968,
+              "the layout of the snapshot files changed");
+
+/**
+ * @brief Check that a snapshot is of this version and that its counts fit in
+ * its arrays.
+ *
+ * @param snapshot
+ * @return true
+ * @return false
+ */
+bool checkSnapshot(const GameSnapshot &snapshot);
+/**
+ * @brief Write a snapshot in a file.
+ *
+ * @param fileName
+ * @param snapshot
+ * @return true
+ * @return false
+ */
+bool writeSnapshot(const std::string &fileName, const GameSnapshot &snapshot);
+/**
+ * @brief Read a snapshot written by writeSnapshot.
+ *
+ * @param fileName
+ * @param snapshot
+ * @return true
+ * @return false if the file is missing or is not a snapshot of this version
+ */
+bool readSnapshot(const std::string &fileName, GameSnapshot &snapshot);
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef SQUARE_H
 #define SQUARE_H
 
+#include <cstdint>
+
 #define DOT_POINT 10
 #define POWERUP_POINT 50
 
@@ -9,11 +11,14 @@ enum typeItem { _DOT, _POWERUP, _FRUIT, _EMPTY };
 /**
  * @brief This class contains the square's state (wall or hall)
  * and the item on this square (pacman, ghost, dot...).
+ *
+ * @note The square is packed in 4 bytes so that the whole map fits in a few
+ * cache lines, the accessors are defined inline because they are called for
+ * each square read by the pathfinding.
  */
 class square {
   public:
-    square();
-    ~square();
+    square() : _state(0), _item(_EMPTY), _score(0) {}
     /**
      * @brief Set the state of the square.
      *
@@ -22,41 +27,41 @@ class square {
      * @note Short value defines the state : 0 for hall, 1 for wall, 2 for
      * teleportation and 3 for cage's door.
      */
-    void setState(short state);
+    void setState(short state) { _state = uint8_t(state); }
     /**
      * @brief Get the state of the square.
      *
      * @return short
      */
-    short getState();
+    short getState() const { return _state; }
     /**
      * @brief Set the score of the square.
      * @param score
      */
-    void setScore(int score);
+    void setScore(int score) { _score = uint16_t(score); }
     /**
      * @brief Get the score of the square.
      *
      * @return int
      */
-    int getScore();
+    int getScore() const { return _score; }
     /**
      * @brief Set the item on the square.
      *
      * @param typeItem
      */
-    void setItem(typeItem item);
+    void setItem(typeItem item) { _item = uint8_t(item); }
     /**
      * @brief Get the item on the square.
      *
      * @return typeItem
      */
-    typeItem getItem();
+    typeItem getItem() const { return typeItem(_item); }
 
   private:
-    short _state;
-    typeItem _item;
-    int _score;
+    uint8_t _state;
+    uint8_t _item;
+    uint16_t _score;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,90 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include <cstdint>
+
+// fixed, so that the hashes of a state are the same on every build
+#define ZOBRIST_SEED 0x2545f4914f6cdd1dULL
+
+/**
+ * @brief Kind of the keys of the hash of a game.
+ */
+enum zobristPiece {
+    ZOBRIST_DOT,
+    ZOBRIST_POWERUP,
+    ZOBRIST_FRUIT,
+    ZOBRIST_PACMAN,
+    ZOBRIST_GHOST,
+    ZOBRIST_GAME
+};
+
+/**
+ * @brief Mix the bits of a word, the finalizer of splitmix64. The mix is a
+ * bijection, two different words never give the same key.
+ *
+ * @param x
+ * @return uint64_t
+ */
+inline uint64_t zobristMix(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+/**
+ * @brief Get the key of a piece on a square.
+ *
+ * @note The keys are computed instead of being read in a table of random
+ * numbers, they do not depend on the size of the maze and there is no table
+ * to fill when a level is loaded.
+ *
+ * @param piece
+ * @param cell the index of the square, y * width + x
+ * @return uint64_t
+ */
+inline uint64_t zobristKey(zobristPiece piece, uint64_t cell) {
+    return zobristMix((uint64_t(piece) << 56 ^ cell) + ZOBRIST_SEED);
+}
+
+/**
+ * @brief Hash of the fields of an actor or of the game, which changes with
+ * every field: the key of the object in the hash of the game.
+ *
+ * @note Each field is mixed with a salt given by its rank, without the
+ * result of the previous fields, so that the fields are mixed in parallel.
+ */
+class zobristHasher {
+  public:
+    /**
+     * @brief Start the key of an object.
+     *
+     * @param piece
+     * @param id the index of the object, for the ghosts
+     */
+    zobristHasher(zobristPiece piece, uint64_t id = 0)
+        : _hash(zobristKey(piece, id)), _salt(_hash) {}
+    /**
+     * @brief Add a field to the key.
+     *
+     * @param value
+     * @return zobristHasher&
+     */
+    zobristHasher &add(uint64_t value) {
+        _salt += ZOBRIST_SEED;
+        _hash ^= zobristMix(value + _salt);
+        return *this;
+    }
+    /**
+     * @brief Get the key.
+     *
+     * @return uint64_t
+     */
+    uint64_t get() const { return _hash; }
+
+  private:
+    uint64_t _hash, _salt;
+};
+
+#endif
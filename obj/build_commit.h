@@ -0,0 +1 @@
+#define BUILD_COMMIT "8d72dd2"
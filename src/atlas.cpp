@@ -0,0 +1,97 @@
+#include "atlas.h"
+
+spriteAtlas::spriteAtlas() {
+    _opaque = nullptr;
+    _keyed = nullptr;
+}
+
+uint64_t spriteAtlas::key(const DrawCommand &command) {
+    // the sheet is smaller than 1024x1024 pixels and the window than 2048
+    return uint64_t(command.src.x & 0x3ff) |
+           uint64_t(command.src.y & 0x3ff) << 10 |
+           uint64_t(command.src.w & 0x3ff) << 20 |
+           uint64_t(command.src.h & 0x3ff) << 30 |
+           uint64_t(command.dst.w & 0x7ff) << 40 |
+           uint64_t(command.dst.h & 0x7ff) << 51 |
+           uint64_t(command.colorKey) << 62;
+}
+
+bool spriteAtlas::build(SDL_Surface *spriteBoard,
+                        const SDL_PixelFormat *format,
+                        const std::vector<DrawCommand> &sprites) {
+
+    clear();
+
+    // place the sprites on shelves, in each surface
+    std::vector<SDL_Rect> places(sprites.size());
+    int x[2] = {0, 0}, y[2] = {0, 0}, shelf[2] = {0, 0};
+    for (size_t i = 0; i < sprites.size(); i++) {
+        int s = sprites[i].colorKey;
+        const SDL_Rect &dst = sprites[i].dst;
+        if (_rects.count(key(sprites[i])) != 0)
+            continue;
+        if (x[s] + dst.w > ATLAS_WIDTH) {
+            x[s] = 0;
+            y[s] += shelf[s];
+            shelf[s] = 0;
+        }
+        places[i] = {x[s], y[s], dst.w, dst.h};
+        _rects[key(sprites[i])] = places[i];
+        x[s] += dst.w;
+        shelf[s] = std::max(shelf[s], dst.h);
+    }
+
+    // the sheet is converted once to the format of the window
+    SDL_Surface *sheet = SDL_ConvertSurface(spriteBoard, format, 0);
+    _opaque = SDL_CreateRGBSurfaceWithFormat(
+        0, ATLAS_WIDTH, std::max(y[0] + shelf[0], 1), format->BitsPerPixel,
+        format->format);
+    _keyed = SDL_CreateRGBSurfaceWithFormat(
+        0, ATLAS_WIDTH, std::max(y[1] + shelf[1], 1), format->BitsPerPixel,
+        format->format);
+    if (sheet == nullptr || _opaque == nullptr || _keyed == nullptr) {
+        if (sheet != nullptr)
+            SDL_FreeSurface(sheet);
+        clear();
+        return false;
+    }
+
+    // the pixels are copied, whatever the alpha of the formats
+    SDL_SetColorKey(sheet, false, 0);
+    SDL_SetSurfaceBlendMode(sheet, SDL_BLENDMODE_NONE);
+    SDL_SetSurfaceBlendMode(_opaque, SDL_BLENDMODE_NONE);
+    SDL_SetSurfaceBlendMode(_keyed, SDL_BLENDMODE_NONE);
+    for (size_t i = 0; i < sprites.size(); i++) {
+        if (places[i].w == 0)
+            continue;
+        SDL_Rect place = places[i];
+        SDL_BlitScaled(sheet, &sprites[i].src,
+                       sprites[i].colorKey ? _keyed : _opaque, &place);
+    }
+    SDL_FreeSurface(sheet);
+
+    SDL_SetColorKey(_keyed, true, SDL_MapRGB(_keyed->format, 0, 0, 0));
+    SDL_SetSurfaceRLE(_keyed, true);
+    return true;
+}
+
+void spriteAtlas::clear() {
+
+    if (_opaque != nullptr)
+        SDL_FreeSurface(_opaque);
+    if (_keyed != nullptr)
+        SDL_FreeSurface(_keyed);
+    _opaque = nullptr;
+    _keyed = nullptr;
+    _rects.clear();
+}
+
+const SDL_Rect *spriteAtlas::find(const DrawCommand &command,
+                                  SDL_Surface **surface) const {
+
+    auto it = _rects.find(key(command));
+    if (it == _rects.end())
+        return nullptr;
+    *surface = command.colorKey ? _keyed : _opaque;
+    return &it->second;
+}
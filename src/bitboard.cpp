@@ -0,0 +1,114 @@
+#include "bitboard.h"
+#include <algorithm>
+
+/**
+ * @brief Count the bits of a word, without the call to the library made by
+ * __builtin_popcountll when the popcnt instruction is not enabled.
+ *
+ * @param word
+ * @return size_t
+ */
+static inline size_t popCount(uint64_t word) {
+    word = word - ((word >> 1) & 0x5555555555555555ULL);
+    word = (word & 0x3333333333333333ULL) +
+           ((word >> 2) & 0x3333333333333333ULL);
+    word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    return (word * 0x0101010101010101ULL) >> 56;
+}
+
+bitboard::bitboard() {
+    _width = 0;
+    _height = 0;
+    _rowWords = 0;
+}
+
+bitboard::~bitboard() {}
+
+void bitboard::build(gridView vecBoard) {
+
+    _width = vecBoard.getWidth();
+    _height = vecBoard.getHeight();
+    _rowWords = (_width + 63) / 64;
+    _words.assign(NB_LAYERS * _height * _rowWords, 0);
+
+    for (size_t y = 0; y < _height; y++) {
+        for (size_t x = 0; x < _width; x++) {
+            square &Square = vecBoard.at(x, y);
+            if (Square.getState() == HALL)
+                set(LAYER_HALL, x, y);
+            else if (Square.getState() == WALL)
+                set(LAYER_WALL, x, y);
+            else if (Square.getState() == DOOR)
+                set(LAYER_DOOR, x, y);
+
+            if (Square.getItem() == _DOT)
+                set(LAYER_DOT, x, y);
+            else if (Square.getItem() == _POWERUP)
+                set(LAYER_POWERUP, x, y);
+        }
+    }
+}
+
+void bitboard::clear(layer l) {
+    std::fill(_words.begin() + l * _height * _rowWords,
+              _words.begin() + (l + 1) * _height * _rowWords, 0);
+}
+
+size_t bitboard::count(layer l) const {
+
+    size_t total = 0;
+    const uint64_t *word = getRow(l, 0);
+    for (size_t i = 0; i < _height * _rowWords; i++)
+        total += popCount(word[i]);
+    return total;
+}
+
+size_t bitboard::countRow(layer l, size_t y, size_t xMin, size_t xMax) const {
+
+    const uint64_t *row = getRow(l, y);
+    size_t total = 0;
+    for (size_t w = xMin / 64; w <= xMax / 64; w++) {
+        uint64_t word = row[w];
+        // keep the bits of the columns between xMin and xMax
+        if (w == xMin / 64)
+            word &= ~uint64_t(0) << (xMin % 64);
+        if (w == xMax / 64 && xMax % 64 != 63)
+            word &= (uint64_t(1) << (xMax % 64 + 1)) - 1;
+        total += popCount(word);
+    }
+    return total;
+}
+
+size_t bitboard::countInRadius(layer l, size_t x, size_t y,
+                               size_t radius) const {
+
+    size_t total = 0;
+    size_t yMin = y > radius ? y - radius : 0;
+    size_t yMax = std::min(y + radius, _height - 1);
+    for (size_t yRow = yMin; yRow <= yMax; yRow++) {
+        // the squares at this distance form a diamond
+        size_t half = radius - (yRow > y ? yRow - y : y - yRow);
+        size_t xMin = x > half ? x - half : 0;
+        size_t xMax = std::min(x + half, _width - 1);
+        total += countRow(l, yRow, xMin, xMax);
+    }
+    return total;
+}
+
+unsigned bitboard::getLegalMoves(size_t x, size_t y, dir lastDir) const {
+
+    unsigned moves = getNeighbors(LAYER_HALL, x, y);
+    switch (lastDir) {
+    case LEFT:
+        return moves & ~DIR_MASK(RIGHT);
+    case RIGHT:
+        return moves & ~DIR_MASK(LEFT);
+    case UP:
+        return moves & ~DIR_MASK(DOWN);
+    case DOWN:
+        return moves & ~DIR_MASK(UP);
+    case NONE:
+        break;
+    }
+    return moves;
+}
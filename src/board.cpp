@@ -2,125 +2,181 @@
 
 board::board() {}
 
-board::~board() {
-    for (size_t i = 0; i < _board.size(); i++) {
-        for (size_t j = 0; j < _board[i].size(); j++)
-            _board[i][j].reset();
+board::~board() {}
 
-        _board[i].clear();
-    }
-
-    _board.clear();
-}
-
-void board::load() {
+void board::load(const std::string &fileName) {
 
-    std::ifstream inputFile("assets/pacman_board.txt");
-
-    char c;
-    // first column
-    _board.push_back(std::vector<std::shared_ptr<square>>());
-    while (inputFile.get(c)) {
+    if (!_level.load(fileName)) {
+        std::cerr << "Unable to load " << fileName << std::endl;
+        exit(EXIT_FAILURE);
+    }
 
-        if (c == '\n') {
-            // next column
-            _board.push_back(std::vector<std::shared_ptr<square>>());
-        } else {
-            std::shared_ptr<square> Square = std::make_shared<square>();
-            Square->setState(c - '0');
-            Square->setItem(_EMPTY);
-            _board.back().push_back(Square);
+    // the path tables are saved next to the level
+    size_t slash = fileName.find_last_of('/');
+    size_t dot = fileName.find_last_of('.');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+        dot = fileName.size();
+    _pathFile = fileName.substr(0, dot) + PATH_TABLE_EXTENSION;
+
+    _board.resize(_level.getWidth(), _level.getHeight());
+    for (size_t y = 0; y < _board.getHeight(); y++) {
+        for (size_t x = 0; x < _board.getWidth(); x++) {
+            square &Square = _board.at(x, y);
+            Square.setState(_level.getState(x, y));
+            Square.setItem(_EMPTY);
         }
     }
 }
 
-std::vector<std::vector<std::shared_ptr<square>>> board::getBoard() {
-    return _board;
-}
+const level &board::getLevel() { return _level; }
 
-void board::transpose() {
+gridView board::getBoard() {
+    return _board.getView(_paths.get(),
+                          _pellets.isBuilt() ? &_pellets : nullptr);
+}
 
-    const size_t numRows = _board.size();
-    const size_t numCols = _board.empty() ? 0 : _board[0].size();
-    std::vector<std::vector<std::shared_ptr<square>>> tBoard(
-        numCols, std::vector<std::shared_ptr<square>>(numRows));
+void board::loadPaths(std::shared_ptr<const pathTable> paths) {
 
-    for (size_t i = 0; i < numRows; ++i) {
-        for (size_t j = 0; j < numCols; ++j) {
-            tBoard[j][i] = _board[i][j];
-        }
+    _paths.reset();
+    if (paths != nullptr && paths->matches(_board.getView())) {
+        _paths = paths;
+        return;
     }
 
-    _board = tBoard;
+    size_t nbCells = 0;
+    for (size_t y = 0; y < _board.getHeight(); y++) {
+        for (size_t x = 0; x < _board.getWidth(); x++)
+            nbCells += _board.at(x, y).getState() != WALL;
+    }
+    if (nbCells > PATH_TABLE_MAX_CELLS)
+        return;
+
+    auto newPaths = std::make_shared<pathTable>();
+    if (!newPaths->load(_pathFile, _board.getView())) {
+        newPaths->build(_board.getView());
+        if (!newPaths->save(_pathFile))
+            std::cerr << "Unable to save " << _pathFile << std::endl;
+    }
+    _paths = newPaths;
 }
 
+std::shared_ptr<const pathTable> board::getPathTables() { return _paths; }
+
 void board::setItem() {
 
     // Dot
-    size_t i = 0, j = 0;
-    for (i = 0; i < _board.size(); i++) {
-        for (j = 0; j < _board[i].size(); j++) {
-            std::shared_ptr<square> Square = _board[i][j];
-            if (Square->getState() == 0) {
-                // teleportation hallway
-                if (j == 13 && (i != 5 && i != 15))
-                    Square->setItem(_EMPTY);
-                // middle of the map
-                else if (i >= 6 && i <= 14 && j >= 9 && j <= 17)
-                    Square->setItem(_EMPTY);
-                // pacman spawn
-                else if (i == 10 && j == 20)
-                    Square->setItem(_EMPTY);
+    for (size_t y = 0; y < _board.getHeight(); y++) {
+        for (size_t x = 0; x < _board.getWidth(); x++) {
+            square &Square = _board.at(x, y);
+            if (Square.getState() == HALL) {
+                // tunnels, middle of the map and pacman spawn
+                if (_level.isEmpty(x, y))
+                    Square.setItem(_EMPTY);
                 else {
-                    Square->setItem(_DOT);
-                    Square->setScore(DOT_POINT);
+                    Square.setItem(_DOT);
+                    Square.setScore(DOT_POINT);
                 }
             }
         }
     }
 
     // Powerup
-    _board[1][3]->setItem(_POWERUP);
-    _board[1][3]->setScore(POWERUP_POINT);
-    _board[19][3]->setItem(_POWERUP);
-    _board[19][3]->setScore(POWERUP_POINT);
-    _board[1][20]->setItem(_POWERUP);
-    _board[1][20]->setScore(POWERUP_POINT);
-    _board[19][20]->setItem(_POWERUP);
-    _board[19][20]->setScore(POWERUP_POINT);
+    for (auto &coord : _level.getPowerups()) {
+        _board.at(coord.x, coord.y).setItem(_POWERUP);
+        _board.at(coord.x, coord.y).setScore(POWERUP_POINT);
+    }
+
+    _pellets.build(_board.getView());
 }
 
-std::vector<Coordinate> board::getDotList() {
-
-    std::vector<Coordinate> vecDot;
-    Coordinate coord;
-    for (size_t i = 0; i < _board.size(); i++) {
-        for (size_t j = 0; j < _board[i].size(); j++) {
-            std::shared_ptr<square> Square = _board[i][j];
-            if (Square->getItem() == _DOT) {
-                coord.x = i;
-                coord.y = j;
-                vecDot.push_back(coord);
-            }
-        }
+const std::vector<Coordinate> &board::getDotList() {
+    return _pellets.getDotList();
+}
+
+const std::vector<Coordinate> &board::getPowerupList() {
+    return _pellets.getPowerupList();
+}
+
+const bitboard &board::getBits() { return _pellets.getBits(); }
+
+void board::setActors(pacman &Pacman, ghostPack &Ghosts) {
+
+    bitboard &bits = _pellets.getBits();
+    gridView view = _board.getView();
+    bits.clear(LAYER_PACMAN);
+    bits.clear(LAYER_GHOST);
+
+    // the actors in the tunnel may be outside the board
+    size_t x = Pacman.getPos().first / SCALE_PIXEL;
+    size_t y = Pacman.getPos().second / SCALE_PIXEL;
+    if (view.isInside(x, y))
+        bits.set(LAYER_PACMAN, x, y);
+    for (size_t i = 0; i < Ghosts.size(); i++) {
+        x = Ghosts.getPos(i).first / SCALE_PIXEL;
+        y = Ghosts.getPos(i).second / SCALE_PIXEL;
+        if (view.isInside(x, y))
+            bits.set(LAYER_GHOST, x, y);
     }
+}
+
+bool board::savePellets(uint64_t *dots, uint64_t *powerups) {
+
+    const bitboard &bits = _pellets.getBits();
+    if (bits.getRowWords() > 1 || _board.getHeight() > SNAPSHOT_MAX_ROWS)
+        return false;
 
-    return vecDot;
+    for (size_t y = 0; y < _board.getHeight(); y++) {
+        dots[y] = bits.getRow(LAYER_DOT, y)[0];
+        powerups[y] = bits.getRow(LAYER_POWERUP, y)[0];
+    }
+    return true;
 }
 
-std::vector<Coordinate> board::getPowerupList() {
-
-    std::vector<Coordinate> vecPowerup;
-    Coordinate coord;
-    for (size_t i = 0; i < _board.size(); i++) {
-        for (size_t j = 0; j < _board[i].size(); j++) {
-            std::shared_ptr<square> Square = _board[i][j];
-            if (Square->getItem() == _POWERUP) {
-                coord.x = i;
-                coord.y = j;
-                vecPowerup.push_back(coord);
+void board::restorePellets(const uint64_t *dots, const uint64_t *powerups) {
+
+    const bitboard &bits = _pellets.getBits();
+    for (size_t y = 0; y < _board.getHeight(); y++) {
+        uint64_t dotChanges = bits.getRow(LAYER_DOT, y)[0] ^ dots[y];
+        uint64_t powerupChanges =
+            bits.getRow(LAYER_POWERUP, y)[0] ^ powerups[y];
+
+        // the items eaten since the save are put back, the items eaten after
+        // it are removed
+        for (uint64_t changes = dotChanges | powerupChanges; changes != 0;
+             changes &= changes - 1) {
+            size_t x = __builtin_ctzll(changes);
+            square &Square = _board.at(x, y);
+            _pellets.remove(x, y);
+            if ((dots[y] >> x) & 1) {
+                Square.setItem(_DOT);
+                Square.setScore(DOT_POINT);
+                _pellets.add(x, y, _DOT);
+            } else if ((powerups[y] >> x) & 1) {
+                Square.setItem(_POWERUP);
+                Square.setScore(POWERUP_POINT);
+                _pellets.add(x, y, _POWERUP);
+            } else {
+                Square.setItem(_EMPTY);
+                Square.setScore(0);
             }
         }
     }
-    return vecPowerup;
+}
+
+uint64_t board::getHash() { return _pellets.getHash(); }
+
+uint64_t board::computeHash() {
+
+    uint64_t hash = 0;
+    for (size_t y = 0; y < _board.getHeight(); y++) {
+        for (size_t x = 0; x < _board.getWidth(); x++) {
+            typeItem item = _board.at(x, y).getItem();
+            if (item == _DOT)
+                hash ^= zobristKey(ZOBRIST_DOT, y * _board.getWidth() + x);
+            else if (item == _POWERUP)
+                hash ^=
+                    zobristKey(ZOBRIST_POWERUP, y * _board.getWidth() + x);
+        }
+    }
+    return hash;
 }
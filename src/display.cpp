@@ -0,0 +1,351 @@
+#include "display.h"
+#include <algorithm>
+#include <tuple>
+
+display::display() {
+    _window = nullptr;
+    _target = nullptr;
+    _sprites = nullptr;
+    _renderer = nullptr;
+    _texture = nullptr;
+    _textureWidth = 0;
+    _textureHeight = 0;
+}
+
+bool display::open(SDL_Window *Window, SDL_Surface *spriteBoard,
+                   backend Backend) {
+
+    _window = Window;
+    _sprites = spriteBoard;
+    _previous.clear();
+    if (Backend == BACKEND_SURFACE) {
+        _target = SDL_GetWindowSurface(Window);
+        return _target != nullptr && buildAtlas();
+    }
+
+    // the copies are batched by SDL when SDL_RenderGeometry is missing
+    SDL_SetHint(SDL_HINT_RENDER_BATCHING, "1");
+    if (Backend == BACKEND_TEXTURE)
+        _renderer = SDL_CreateRenderer(Window, -1, SDL_RENDERER_ACCELERATED);
+    // no GPU
+    if (_renderer == nullptr)
+        _renderer = SDL_CreateRenderer(Window, -1, SDL_RENDERER_SOFTWARE);
+    return _renderer != nullptr && upload();
+}
+
+bool display::open(SDL_Surface *target, SDL_Surface *spriteBoard,
+                   backend Backend) {
+
+    _window = nullptr;
+    _target = target;
+    _sprites = spriteBoard;
+    _previous.clear();
+    if (Backend == BACKEND_SURFACE)
+        return buildAtlas();
+
+    SDL_SetHint(SDL_HINT_RENDER_BATCHING, "1");
+    _renderer = SDL_CreateSoftwareRenderer(target);
+    return _renderer != nullptr && upload();
+}
+
+bool display::buildAtlas() {
+
+    DrawList sprites;
+    listSprites(sprites);
+    return _atlas.build(_sprites, _target->format, sprites.commands);
+}
+
+bool display::upload() {
+
+    // the sprites are scaled without filtering, as SDL_BlitScaled does
+    SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "nearest");
+    SDL_SetColorKey(_sprites, true, 0);
+    _texture = SDL_CreateTextureFromSurface(_renderer, _sprites);
+    SDL_SetColorKey(_sprites, false, 0);
+    if (_texture == nullptr)
+        return false;
+
+    SDL_SetTextureBlendMode(_texture, SDL_BLENDMODE_BLEND);
+    _textureWidth = float(_sprites->w);
+    _textureHeight = float(_sprites->h);
+    return true;
+}
+
+void display::close() {
+
+    if (_texture != nullptr)
+        SDL_DestroyTexture(_texture);
+    if (_renderer != nullptr)
+        SDL_DestroyRenderer(_renderer);
+    _texture = nullptr;
+    _renderer = nullptr;
+    _atlas.clear();
+    clearTexts();
+}
+
+void display::clearTexts() {
+
+    for (auto &text : _texts)
+        SDL_FreeSurface(text.second);
+    _texts.clear();
+}
+
+SDL_Surface *display::getText(const std::string &str) {
+
+    auto it = _texts.find(str);
+    if (it != _texts.end())
+        return it->second;
+    if (_texts.size() >= TEXT_CACHE_SIZE)
+        clearTexts();
+
+    SDL_Surface *text = SDL_CreateRGBSurfaceWithFormat(
+        0, GLYPH_SIZE * (int(str.length()) + 2), GLYPH_SIZE,
+        _target->format->BitsPerPixel, _target->format->format);
+    if (text == nullptr)
+        return nullptr;
+    SDL_SetSurfaceBlendMode(text, SDL_BLENDMODE_NONE);
+    SDL_FillRect(text, nullptr, 0);
+
+    // the characters are copied from the atlas, the text is black around
+    SDL_Rect glyph = {0, 0, GLYPH_SIZE, GLYPH_SIZE};
+    for (auto c : str) {
+        DrawCommand command = {*getCharSprite(c), glyph, false, -1};
+        SDL_Surface *scaled = nullptr;
+        const SDL_Rect *src = _atlas.find(command, &scaled);
+        SDL_Rect dst = glyph;
+        if (src != nullptr)
+            SDL_BlitSurface(scaled, src, text, &dst);
+        else {
+            SDL_SetColorKey(_sprites, false, 0);
+            SDL_BlitScaled(_sprites, &command.src, text, &dst);
+        }
+        glyph.x += GLYPH_SIZE;
+    }
+
+    _texts[str] = text;
+    return text;
+}
+
+void display::show(const DrawList &list) {
+
+    if (_renderer == nullptr)
+        showSurface(list);
+    else
+        showTexture(list);
+}
+
+/**
+ * @brief Order of the drawings, to compare two frames.
+ *
+ * @param a
+ * @param listA the list of a, with its text
+ * @param b
+ * @param listB the list of b, with its text
+ * @return true if a is before b
+ * @return false
+ */
+static bool lessCommand(const DrawCommand &a, const DrawList &listA,
+                        const DrawCommand &b, const DrawList &listB) {
+    auto keyA = std::tie(a.dst.x, a.dst.y, a.dst.w, a.dst.h, a.src.x, a.src.y,
+                         a.src.w, a.src.h, a.colorKey);
+    auto keyB = std::tie(b.dst.x, b.dst.y, b.dst.w, b.dst.h, b.src.x, b.src.y,
+                         b.src.w, b.src.h, b.colorKey);
+    if (keyA != keyB)
+        return keyA < keyB;
+    // the texts are compared by their content
+    if (a.text < 0 || b.text < 0)
+        return a.text < b.text;
+    return listA.texts[a.text] < listB.texts[b.text];
+}
+
+bool display::findDirty(const DrawList &list) {
+
+    _current.commands.assign(list.commands.begin(), list.commands.end());
+    _current.texts.assign(list.texts.begin(), list.texts.end());
+    std::sort(_current.commands.begin(), _current.commands.end(),
+              [this](const DrawCommand &a, const DrawCommand &b) {
+                  return lessCommand(a, _current, b, _current);
+              });
+    bool whole = _previous.commands.empty();
+
+    // the drawings in only one of the frames
+    _dirty.clear();
+    auto prev = _previous.commands.begin(), cur = _current.commands.begin();
+    auto prevEnd = _previous.commands.end(), curEnd = _current.commands.end();
+    while (!whole && (prev != prevEnd || cur != curEnd)) {
+        if (cur == curEnd || (prev != prevEnd && lessCommand(*prev, _previous,
+                                                             *cur, _current)))
+            _dirty.push_back((prev++)->dst);
+        else if (prev == prevEnd ||
+                 lessCommand(*cur, _current, *prev, _previous))
+            _dirty.push_back((cur++)->dst);
+        else {
+            prev++;
+            cur++;
+        }
+    }
+    std::swap(_previous, _current);
+    if (whole)
+        return false;
+
+    // keep the areas in the window and join the ones which overlap, so that
+    // no pixel is drawn twice
+    SDL_Rect window = {0, 0, _target->w, _target->h};
+    size_t nbRects = 0;
+    for (size_t i = 0; i < _dirty.size(); i++) {
+        SDL_Rect rect = _dirty[i];
+        if (SDL_IntersectRect(&rect, &window, &_dirty[nbRects]))
+            nbRects++;
+    }
+    _dirty.resize(nbRects);
+    for (size_t i = 0; i < _dirty.size(); i++) {
+        for (size_t j = i + 1; j < _dirty.size(); j++) {
+            if (SDL_HasIntersection(&_dirty[i], &_dirty[j])) {
+                SDL_Rect rect = _dirty[i];
+                SDL_UnionRect(&rect, &_dirty[j], &_dirty[i]);
+                _dirty.erase(_dirty.begin() + j);
+                // the larger area can overlap the previous ones
+                j = i;
+            }
+        }
+    }
+
+    // a change of screen is drawn at once
+    long area = 0;
+    for (auto &rect : _dirty)
+        area += long(rect.w) * rect.h;
+    return area * DIRTY_MAX_RATIO < long(window.w) * window.h;
+}
+
+void display::blit(const DrawList &list, const DrawCommand &command) {
+
+    // copy of the area, SDL writes the clipped area in it
+    SDL_Rect dst = command.dst;
+    if (command.text >= 0) {
+        SDL_Surface *text = getText(list.texts[command.text]);
+        if (text != nullptr)
+            SDL_BlitSurface(text, nullptr, _target, &dst);
+        return;
+    }
+    if (command.src.w == 0) {
+        SDL_FillRect(_target, &dst, 0);
+        return;
+    }
+    SDL_Surface *scaled = nullptr;
+    const SDL_Rect *src = _atlas.find(command, &scaled);
+    if (src != nullptr) {
+        SDL_BlitSurface(scaled, src, _target, &dst);
+        return;
+    }
+    // sprite missing in the atlas
+    SDL_SetColorKey(_sprites, command.colorKey, 0);
+    SDL_BlitScaled(_sprites, &command.src, _target, &dst);
+}
+
+void display::showSurface(const DrawList &list) {
+
+    if (!findDirty(list)) {
+        for (auto &command : list.commands)
+            blit(list, command);
+        if (_window != nullptr)
+            SDL_UpdateWindowSurface(_window);
+        return;
+    }
+    if (_dirty.empty())
+        return;
+
+    // the areas are cleared and the drawings over them are drawn again in
+    // order, clipped to the area
+    for (auto &rect : _dirty) {
+        SDL_SetClipRect(_target, &rect);
+        SDL_FillRect(_target, &rect, 0);
+        for (auto &command : list.commands) {
+            if (SDL_HasIntersection(&command.dst, &rect))
+                blit(list, command);
+        }
+    }
+    SDL_SetClipRect(_target, nullptr);
+
+    if (_window != nullptr)
+        SDL_UpdateWindowSurfaceRects(_window, _dirty.data(),
+                                     int(_dirty.size()));
+}
+
+void display::showTexture(const DrawList &list) {
+
+    SDL_SetRenderDrawColor(_renderer, 0, 0, 0, 255);
+    SDL_RenderClear(_renderer);
+
+    // the consecutive sprites are sent together, as the consecutive fills
+    for (auto &command : list.commands) {
+        if (command.src.w == 0) {
+            flushSprites();
+            _fills.push_back(command.dst);
+        }
+        // the characters of a text are sprites of the texture
+        if (command.text >= 0) {
+            flushFills();
+            SDL_Rect glyph = {command.dst.x, command.dst.y, GLYPH_SIZE,
+                              GLYPH_SIZE};
+            for (auto c : list.texts[command.text]) {
+                addQuad(*getCharSprite(c), glyph);
+                glyph.x += GLYPH_SIZE;
+            }
+        } else if (command.src.w != 0) {
+            flushFills();
+            addQuad(command.src, command.dst);
+        }
+    }
+    flushFills();
+    flushSprites();
+
+    SDL_RenderPresent(_renderer);
+}
+
+void display::addQuad(const SDL_Rect &src, const SDL_Rect &dst) {
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    const SDL_Color white = {255, 255, 255, 255};
+    float u0 = src.x / _textureWidth;
+    float v0 = src.y / _textureHeight;
+    float u1 = (src.x + src.w) / _textureWidth;
+    float v1 = (src.y + src.h) / _textureHeight;
+    float x0 = float(dst.x);
+    float y0 = float(dst.y);
+    float x1 = float(dst.x + dst.w);
+    float y1 = float(dst.y + dst.h);
+
+    // two triangles on the corners of the area
+    int first = int(_vertices.size());
+    _vertices.push_back({{x0, y0}, white, {u0, v0}});
+    _vertices.push_back({{x1, y0}, white, {u1, v0}});
+    _vertices.push_back({{x0, y1}, white, {u0, v1}});
+    _vertices.push_back({{x1, y1}, white, {u1, v1}});
+    for (int corner : {0, 1, 2, 2, 1, 3})
+        _indices.push_back(first + corner);
+#else
+    SDL_RenderCopy(_renderer, _texture, &src, &dst);
+#endif
+}
+
+void display::flushSprites() {
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    if (_indices.empty())
+        return;
+    SDL_RenderGeometry(_renderer, _texture, _vertices.data(),
+                       int(_vertices.size()), _indices.data(),
+                       int(_indices.size()));
+    _vertices.clear();
+    _indices.clear();
+#endif
+}
+
+void display::flushFills() {
+
+    if (_fills.empty())
+        return;
+    SDL_SetRenderDrawColor(_renderer, 0, 0, 0, 255);
+    SDL_RenderFillRects(_renderer, _fills.data(), int(_fills.size()));
+    _fills.clear();
+}
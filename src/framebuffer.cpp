@@ -0,0 +1,19 @@
+#include "framebuffer.h"
+
+frameBuffer::frameBuffer() : _middle(1) {
+    _back = 0;
+    _front = 2;
+}
+
+void frameBuffer::publish() {
+    // the frame is written before the exchange which gives it
+    _back = _middle.exchange(_back | NEW_FRAME, std::memory_order_acq_rel) &
+            ~NEW_FRAME;
+}
+
+bool frameBuffer::consume() {
+    if ((_middle.load(std::memory_order_relaxed) & NEW_FRAME) == 0)
+        return false;
+    _front = _middle.exchange(_front, std::memory_order_acq_rel) & ~NEW_FRAME;
+    return true;
+}
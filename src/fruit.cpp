@@ -1,6 +1,6 @@
 #include "fruit.h"
 
-std::vector<int> vecFruitScore = {
+const std::vector<int> vecFruitScore = {
     0,    // NONE
     100,  // CHERRY_SCORE
     300,  // STRAWBERRY_SCORE
@@ -12,18 +12,19 @@ std::vector<int> vecFruitScore = {
     5000  // KEY_SCORE
 };
 
-fruit::fruit() {
+fruit::fruit(const gameClock &clock, const level &Level) {
+    _clock = &clock;
+    _pos = Level.getFruit();
     _fruit = _NONE;
     _lastFruit = _NONE;
+    timeFruit1 = 0;
 }
 
 fruit::~fruit() {}
 
 typeFruit fruit::getFruit() { return _fruit; }
 
-int fruit::updateFruit(
-    std::vector<std::vector<std::shared_ptr<square>>> vecBoard, int dotCounter,
-    int fruitCounter) {
+int fruit::updateFruit(gridView vecBoard, int dotCounter, int fruitCounter) {
 
     if (dotCounter >= MIN_DOT_FRUIT + (fruitCounter * MIN_DOT_FRUIT_STEP)) {
 
@@ -32,32 +33,58 @@ int fruit::updateFruit(
 
             _lastFruit = (_lastFruit + 1) % 9;
             _fruit = typeFruit(_lastFruit);
-            timeFruit1 = std::chrono::steady_clock::now();
-            vecBoard[FRUIT_X][FRUIT_Y]->setItem(_FRUIT);
-            vecBoard[FRUIT_X][FRUIT_Y]->setScore(vecFruitScore[_fruit]);
+            timeFruit1 = _clock->now();
+            vecBoard.at(_pos.x, _pos.y).setItem(_FRUIT);
+            vecBoard.at(_pos.x, _pos.y).setScore(vecFruitScore[_fruit]);
             return SET;
         }
 
-        time_t timeFruit2 = std::chrono::steady_clock::now();
-        std::chrono::duration<double> elapsedTimeFruit =
-            timeFruit2 - timeFruit1;
-
         if (_fruit != _NONE &&
-            (elapsedTimeFruit.count() >= TIME_TO_SPAWN_FRUIT)) {
+            (_clock->getElapsed(timeFruit1) >= TIME_TO_SPAWN_FRUIT)) {
 
             _fruit = _NONE;
-            vecBoard[FRUIT_X][FRUIT_Y]->setItem(_EMPTY);
-            vecBoard[FRUIT_X][FRUIT_Y]->setScore(0);
+            vecBoard.at(_pos.x, _pos.y).setItem(_EMPTY);
+            vecBoard.at(_pos.x, _pos.y).setScore(0);
             return EXCEED;
         }
     }
     return NO_UPDATE;
 }
 
-void fruit::eatFruit(
-    std::vector<std::vector<std::shared_ptr<square>>> vecBoard) {
+void fruit::eatFruit(gridView vecBoard) {
 
     _fruit = _NONE;
-    vecBoard[FRUIT_X][FRUIT_Y]->setItem(_EMPTY);
-    vecBoard[FRUIT_X][FRUIT_Y]->setScore(0);
-}
\ No newline at end of file
+    vecBoard.at(_pos.x, _pos.y).setItem(_EMPTY);
+    vecBoard.at(_pos.x, _pos.y).setScore(0);
+}
+void fruit::save(FruitState &state) const {
+    state = FruitState();
+    state.timer = timeFruit1;
+    state.lastFruit = _lastFruit;
+    state.fruit = _fruit;
+}
+
+void fruit::restore(const FruitState &state, gridView vecBoard) {
+
+    timeFruit1 = state.timer;
+    _lastFruit = state.lastFruit;
+    _fruit = typeFruit(state.fruit);
+
+    square &Square = vecBoard.at(_pos.x, _pos.y);
+    if (_fruit != _NONE) {
+        Square.setItem(_FRUIT);
+        Square.setScore(vecFruitScore[_fruit]);
+    } else if (Square.getItem() == _FRUIT) {
+        Square.setItem(_EMPTY);
+        Square.setScore(0);
+    }
+}
+
+uint64_t fruit::getHash() const {
+    // the timer only matters while the fruit is shown
+    return zobristHasher(ZOBRIST_FRUIT)
+        .add(_fruit)
+        .add(_lastFruit)
+        .add(_fruit != _NONE ? timeFruit1 : 0)
+        .get();
+}
@@ -1,10 +1,14 @@
-#include "ghost.h"
-
-ghost::ghost() {
+#include "ghostpack.h"
+
+ghost::ghost(ghostPack &pack, size_t id, const gameClock &clock,
+             const level &Level, rng &random) {
+    _pack = &pack;
+    _id = id;
+    _clock = &clock;
+    _level = &Level;
+    _rng = &random;
     _xBoard = 0;
     _yBoard = 0;
-    _xPixel = 0;
-    _yPixel = 0;
     _xPixelEaten = 0;
     _yPixelEaten = 0;
     _lastDir = NONE;
@@ -21,55 +25,31 @@ ghost::ghost() {
     _isInTunnel = false;
     _blueRed = false;
     _bluePink = false;
+    modeTimer1 = 0;
+    blueTimer1 = 0;
 }
 ghost::~ghost() {}
 
 void ghost::setGhost(color c) {
     _color = c;
-    switch (c) {
-    case RED:
-        _isInHouse = true;
-        _xBoard = GHOST_INIT_X;
-        _yBoard = GHOST_INIT_Y;
-        _xPixel = GHOST_INIT_X * SCALE_PIXEL + GHOST_CENTER_X;
-        _yPixel = GHOST_INIT_Y * SCALE_PIXEL + GHOST_CENTER_Y;
-        break;
-    case PINK:
-        _isInHouse = true;
-        _xBoard = PINK_GHOST_INIT_X;
-        _yBoard = PINK_GHOST_INIT_Y;
-        _xPixel = PINK_GHOST_INIT_X * SCALE_PIXEL + GHOST_CENTER_X;
-        _yPixel = PINK_GHOST_INIT_Y * SCALE_PIXEL + GHOST_CENTER_Y;
-        break;
-    case BLUE:
-        _isInHouse = true;
-        _xBoard = BLUE_GHOST_INIT_X;
-        _yBoard = BLUE_GHOST_INIT_Y;
-        _xPixel = BLUE_GHOST_INIT_X * SCALE_PIXEL + GHOST_CENTER_X;
-        _yPixel = BLUE_GHOST_INIT_Y * SCALE_PIXEL + GHOST_CENTER_Y;
-        break;
-    case ORANGE:
-        _isInHouse = true;
-        _xBoard = ORANGE_GHOST_INIT_X;
-        _yBoard = ORANGE_GHOST_INIT_Y;
-        _xPixel = ORANGE_GHOST_INIT_X * SCALE_PIXEL + GHOST_CENTER_X;
-        _yPixel = ORANGE_GHOST_INIT_Y * SCALE_PIXEL + GHOST_CENTER_Y;
-        break;
-    }
+    _isInHouse = true;
+    // the red ghost starts above the door
+    Coordinate spawn =
+        c == RED ? _level->getGhostExit() : _level->getGhostHome(c);
+    _xBoard = spawn.x;
+    _yBoard = spawn.y;
+    xPixel() = _xBoard * SCALE_PIXEL + GHOST_CENTER_X;
+    yPixel() = _yBoard * SCALE_PIXEL + GHOST_CENTER_Y;
 }
 
 color ghost::getGhost() { return _color; }
 
 bool ghost::isInHouse() { return _isInHouse; }
 
-void ghost::updateInHouse(
-    std::vector<std::vector<std::shared_ptr<square>>> vecBoard, int level,
-    int dotCounter, int life, time_t noEatenDotTimer1) {
+void ghost::updateInHouse(gridView vecBoard, int level, int dotCounter,
+                          int life, tick_t noEatenDotTimer1) {
 
-    time_t noEatenDotTimer2 = std::chrono::steady_clock::now();
-    std::chrono::duration<double> elapsedTime =
-        noEatenDotTimer2 - noEatenDotTimer1;
-    if (elapsedTime.count() >= NO_EATEN_DOT_TIME)
+    if (_clock->getElapsed(noEatenDotTimer1) >= NO_EATEN_DOT_TIME)
         _isTime = true;
 
     // wait in ghost house
@@ -103,21 +83,25 @@ void ghost::updateInHouse(
         break;
     }
 
+    // the door is below the exit, then the lines where the ghosts wait
+    Coordinate houseExit = _level->getGhostExit();
+    size_t yHouse = houseExit.y + 2;
+
     // move in ghost house
     if (_isTime == false) {
 
-        if (_yBoard == 13) {
-            if (_yPixel + GHOST_SLOW_SPEED >= _yBoard * SCALE_PIXEL +
+        if (_yBoard == yHouse + 1) {
+            if (yPixel() + GHOST_SLOW_SPEED >= _yBoard * SCALE_PIXEL +
                                                   GHOST_CENTER_X -
                                                   GHOST_SLOW_RANGE_CENTER)
-                _yPixel = _yBoard * SCALE_PIXEL + GHOST_CENTER_X;
+                yPixel() = _yBoard * SCALE_PIXEL + GHOST_CENTER_X;
             _lastDir = UP;
             _yBoard -= GHOST_SLOW_SPEED;
-        } else if (_yBoard == 12) {
-            if (_yPixel + GHOST_SLOW_SPEED <= _yBoard * SCALE_PIXEL +
+        } else if (_yBoard == yHouse) {
+            if (yPixel() + GHOST_SLOW_SPEED <= _yBoard * SCALE_PIXEL +
                                                   GHOST_CENTER_X +
                                                   GHOST_SLOW_RANGE_CENTER)
-                _yPixel = _yBoard * SCALE_PIXEL + GHOST_CENTER_X;
+                yPixel() = _yBoard * SCALE_PIXEL + GHOST_CENTER_X;
             _lastDir = DOWN;
             _yBoard += GHOST_SLOW_SPEED;
         }
@@ -125,43 +109,43 @@ void ghost::updateInHouse(
     // move out ghost house
     else {
         // if the ghost has left the house
-        if (_xBoard == GHOST_INIT_X && _yBoard == GHOST_INIT_Y) {
+        if (_xBoard == size_t(houseExit.x) && _yBoard == size_t(houseExit.y)) {
             // reset pixel position
-            _xPixel = GHOST_INIT_X * SCALE_PIXEL + GHOST_CENTER_X;
-            _yPixel = GHOST_INIT_Y * SCALE_PIXEL + GHOST_CENTER_Y;
+            xPixel() = houseExit.x * SCALE_PIXEL + GHOST_CENTER_X;
+            yPixel() = houseExit.y * SCALE_PIXEL + GHOST_CENTER_Y;
             _mode = ANY;
             _isInHouse = false;
             _lastDir = NONE;
             return;
         }
 
-        // next condition are set only for the 12th line
-        if (_yBoard == 13) {
+        // next condition are set only for the lowest line of the house
+        if (_yBoard == yHouse + 1) {
             _yBoard -= GHOST_SLOW_SPEED;
             _lastDir = UP;
             return;
         }
 
         // in the door
-        if (vecBoard[_xBoard][_yBoard]->getState() == DOOR) {
+        if (vecBoard.at(_xBoard, _yBoard).getState() == DOOR) {
             _yBoard -= GHOST_SLOW_SPEED;
             _lastDir = UP;
             return;
         }
         // at the bottom of the door
-        else if (vecBoard[_xBoard][_yBoard - 1]->getState() == DOOR) {
+        else if (vecBoard.at(_xBoard, _yBoard - 1).getState() == DOOR) {
             _yBoard -= GHOST_SLOW_SPEED;
             _lastDir = UP;
             return;
         }
         // at the bottom left of the door
-        else if (vecBoard[_xBoard + 1][_yBoard - 1]->getState() == DOOR) {
+        else if (vecBoard.at(_xBoard + 1, _yBoard - 1).getState() == DOOR) {
             _xBoard += GHOST_SLOW_SPEED;
             _lastDir = RIGHT;
             return;
         }
         // at the bottom right of the door
-        else if (vecBoard[_xBoard - 1][_yBoard - 1]->getState() == DOOR) {
+        else if (vecBoard.at(_xBoard - 1, _yBoard - 1).getState() == DOOR) {
             _xBoard -= GHOST_SLOW_SPEED;
             _lastDir = LEFT;
             return;
@@ -177,84 +161,61 @@ void ghost::setReturnHouse() {
     _isFear = false;
 
     // update eaten position
-    _xPixelEaten = _xPixel;
-    _yPixelEaten = _yPixel;
+    _xPixelEaten = xPixel();
+    _yPixelEaten = yPixel();
 }
 
-void ghost::returnHouse(
-    std::vector<std::vector<std::shared_ptr<square>>> vecBoard) {
+void ghost::returnHouse(gridView vecBoard) {
 
     _mode = ANY;
 
+    Coordinate home = _level->getGhostHome(_color);
+    Coordinate houseExit = _level->getGhostExit();
+
     // arrive at the house
-    if ((_color == RED && _xBoard == RED_GHOST_INIT_X &&
-         _yBoard == RED_GHOST_INIT_Y) ||
-        (_color == PINK && _xBoard == PINK_GHOST_INIT_X &&
-         _yBoard == PINK_GHOST_INIT_Y) ||
-        (_color == BLUE && _xBoard == BLUE_GHOST_INIT_X &&
-         _yBoard == BLUE_GHOST_INIT_Y) ||
-        (_color == ORANGE && _xBoard == ORANGE_GHOST_INIT_X &&
-         _yBoard == ORANGE_GHOST_INIT_Y)) {
+    if (_xBoard == size_t(home.x) && _yBoard == size_t(home.y)) {
 
         _isReturnHouse = false;
         _lastDir = NONE;
         _isInHouse = true;
 
         if (_color == RED) {
-            _xBoard = RED_GHOST_INIT_X;
-            _yBoard = RED_GHOST_INIT_Y;
-            _xPixel = RED_GHOST_INIT_X * SCALE_PIXEL + GHOST_CENTER_X;
-            _yPixel = RED_GHOST_INIT_Y * SCALE_PIXEL + GHOST_CENTER_Y;
+            xPixel() = home.x * SCALE_PIXEL + GHOST_CENTER_X;
+            yPixel() = home.y * SCALE_PIXEL + GHOST_CENTER_Y;
         } else
             setGhost(_color);
         return;
     }
 
-    // go the initial position
-    if (_xBoard == 10 && _yBoard == 10) {
-        _lastDir = DOWN;
-        _yBoard++;
-        return;
-    } else if (_xBoard == 10 && _yBoard == 11) {
+    // go the initial position, through the door below the exit
+    if (_xBoard == size_t(houseExit.x) &&
+        (_yBoard == size_t(houseExit.y) ||
+         _yBoard == size_t(houseExit.y) + 1)) {
         _lastDir = DOWN;
         _yBoard++;
         return;
     }
 
-    switch (_color) {
-    case RED:
-        if (_xBoard == 10 && _yBoard == 12) {
-            _lastDir = DOWN;
-            _yBoard++;
-            return;
-        }
-        break;
-    case PINK:
-
-        if (_xBoard == 10 && _yBoard == 12) {
+    if (_xBoard == size_t(houseExit.x) && _yBoard == size_t(houseExit.y) + 2) {
+        switch (_color) {
+        case RED:
+        case PINK:
             _lastDir = DOWN;
             _yBoard++;
             return;
-        }
-        break;
-    case BLUE:
-        if (_xBoard == 10 && _yBoard == 12) {
+        case BLUE:
             _lastDir = LEFT;
             _xBoard--;
             return;
-        }
-        break;
-    case ORANGE:
-        if (_xBoard == 10 && _yBoard == 12) {
+        case ORANGE:
             _lastDir = RIGHT;
             _xBoard++;
             return;
         }
-        break;
     }
 
     // update direction with shortest path
-    updateDirWithShortestPath(vecBoard, GHOST_INIT_X, GHOST_INIT_Y);
+    updateDirWithShortestPath(vecBoard, houseExit.x, houseExit.y);
 }
 
 bool ghost::isReturnHouse() { return _isReturnHouse; }
@@ -268,7 +229,7 @@ void ghost::setFrightened(bool isFear) {
         _lastDir = NONE;
         _mode = SCATTER;
         _scatterHouse = false;
-        modeTimer1 = std::chrono::steady_clock::now();
+        modeTimer1 = _clock->now();
         _isFear = false;
         return;
 
@@ -304,78 +265,16 @@ void ghost::setFrightened(bool isFear) {
 
 bool ghost::isFrightened() { return _isFear; }
 
+mode ghost::getMode() { return _mode; }
+
 std::pair<size_t, size_t> ghost::getPos() {
-    return std::make_pair(_xPixel, _yPixel);
+    return std::make_pair(xPixel(), yPixel());
 }
 
 std::pair<size_t, size_t> ghost::getEatenPosition() {
     return std::make_pair(_xPixelEaten, _yPixelEaten);
 }
 
-void ghost::updatePos() {
-
-    // normal speed
-    if (_isFear == false && _isReturnHouse == false && _isInTunnel == false &&
-        _isInHouse == false) {
-        switch (_lastDir) {
-        case LEFT:
-            _xPixel -= GHOST_SPEED;
-            break;
-        case RIGHT:
-            _xPixel += GHOST_SPEED;
-            break;
-        case UP:
-            _yPixel -= GHOST_SPEED;
-            break;
-        case DOWN:
-            _yPixel += GHOST_SPEED;
-            break;
-        case NONE:
-            break;
-        }
-    }
-    // speed up the ghost
-    else if (_isFear == false && _isReturnHouse == true &&
-             _isInTunnel == false && _isInHouse == false) {
-        switch (_lastDir) {
-        case LEFT:
-            _xPixel -= GHOST_RETURN_SPEED;
-            break;
-        case RIGHT:
-            _xPixel += GHOST_RETURN_SPEED;
-            break;
-        case UP:
-            _yPixel -= GHOST_RETURN_SPEED;
-            break;
-        case DOWN:
-            _yPixel += GHOST_RETURN_SPEED;
-            break;
-        case NONE:
-            break;
-        }
-    }
-    // slow down the ghost
-    else if ((_isFear == true || _isInTunnel == true || _isInHouse == true) &&
-             _isReturnHouse == false) {
-        switch (_lastDir) {
-        case LEFT:
-            _xPixel -= GHOST_SLOW_SPEED;
-            break;
-        case RIGHT:
-            _xPixel += GHOST_SLOW_SPEED;
-            break;
-        case UP:
-            _yPixel -= GHOST_SLOW_SPEED;
-            break;
-        case DOWN:
-            _yPixel += GHOST_SLOW_SPEED;
-            break;
-        case NONE:
-            break;
-        }
-    }
-}
-
 void ghost::updateCoord() {
 
     switch (_lastDir) {
@@ -396,53 +295,17 @@ void ghost::updateCoord() {
     }
 }
 
-bool ghost::waitSquareCenter() {
-
-    size_t xCenter = _xBoard * SCALE_PIXEL + GHOST_CENTER_X;
-    size_t yCenter = _yBoard * SCALE_PIXEL + GHOST_CENTER_Y;
-
-    // normal speed
-    size_t speed = GHOST_SPEED, range = GHOST_RANGE_CENTER;
-
-    // return house speed
-    if (_isFear == false && _isReturnHouse == true && _isInHouse == false) {
-
-        speed = GHOST_RETURN_SPEED;
-        range = GHOST_RETURN_RANGE_CENTER;
-    }
-    // fear / house / tunnel speed
-    else if ((_isFear == true || _isInTunnel == true || _isInHouse == true) &&
-             _isReturnHouse == false && _isInHouse == false) {
-
-        speed = GHOST_SLOW_SPEED;
-        range = GHOST_SLOW_RANGE_CENTER;
-    }
-    if (_lastDir == LEFT && _xPixel - speed <= xCenter + range) {
-        _xPixel = _xBoard * SCALE_PIXEL + GHOST_CENTER_X;
-        return true;
-    } else if (_lastDir == RIGHT && _xPixel + speed >= xCenter - range) {
-        _xPixel = _xBoard * SCALE_PIXEL + GHOST_CENTER_X;
-        return true;
-    } else if (_lastDir == UP && _yPixel + speed <= yCenter + range) {
-        _yPixel = _yBoard * SCALE_PIXEL + GHOST_CENTER_Y;
-        return true;
-    } else if (_lastDir == DOWN && _yPixel + speed >= yCenter - range) {
-        _yPixel = _yBoard * SCALE_PIXEL + GHOST_CENTER_Y;
-        return true;
-    } else if (_lastDir == NONE)
-        return true;
-
-    return false;
-}
-
 dir ghost::getLastDir() { return _lastDir; }
 
-void ghost::updateDir(
-    std::vector<std::vector<std::shared_ptr<square>>> vecBoard, size_t xPac,
-    size_t yPac, dir dirPac, int level, int dotCounter, int life,
-    time_t noEatenDotTimer1) {
+void ghost::updateDir(gridView vecBoard, size_t xPac, size_t yPac, dir dirPac,
+                      int level, int dotCounter, int life,
+                      tick_t noEatenDotTimer1) {
+
+    size_t xMax = vecBoard.getWidth() - 1, yMax = vecBoard.getHeight() - 1;
+    size_t depth = _level->getTunnelDepth();
+    bool tunnel = _level->isTunnel(_yBoard);
 
-    if (_xBoard > 20 || _yBoard == 0 || _yBoard >= 26) {
+    if (_xBoard > xMax || _yBoard == 0 || _yBoard >= yMax) {
         std::cerr << "Ghost out of the board in updateDir" << std::endl;
         exit(EXIT_FAILURE);
     }
@@ -451,21 +314,21 @@ void ghost::updateDir(
         return;
 
     // if ghost is on the teleportation, take it
-    if (_xBoard == 0 && _yBoard == 13 && _lastDir == LEFT) {
-        _xBoard = 20;
-        _xPixel = 20 * SCALE_PIXEL + GHOST_CENTER_X;
-    } else if (_xBoard == 20 && _yBoard == 13 && _lastDir == RIGHT) {
+    if (_xBoard == 0 && tunnel && _lastDir == LEFT) {
+        _xBoard = xMax;
+        xPixel() = xMax * SCALE_PIXEL + GHOST_CENTER_X;
+    } else if (_xBoard == xMax && tunnel && _lastDir == RIGHT) {
         _xBoard = 0;
-        _xPixel = GHOST_CENTER_X;
+        xPixel() = GHOST_CENTER_X;
     }
 
     // if ghost enters in the teleportation hall, go to the teleportation
     // hall
-    if (_xBoard <= 4 && _yBoard == 13 && _lastDir == LEFT) {
+    if (_xBoard <= depth && tunnel && _lastDir == LEFT) {
         _isInTunnel = true;
         _xBoard--;
         return;
-    } else if (_xBoard >= 16 && _yBoard == 13 && _lastDir == RIGHT) {
+    } else if (_xBoard + depth >= xMax && tunnel && _lastDir == RIGHT) {
         _isInTunnel = true;
         _xBoard++;
         return;
@@ -474,7 +337,7 @@ void ghost::updateDir(
     // if ghost takes the teleportation, make him leave the teleportation
     // hall
     // bool inTunnel_ReturnHouse = false;
-    if (_xBoard <= 4 && _yBoard == 13 &&
+    if (_xBoard <= depth && tunnel &&
         (_lastDir == RIGHT || _lastDir == NONE)) {
         _isInTunnel = true;
         // go back to house, keep his speed
@@ -485,7 +348,7 @@ void ghost::updateDir(
         } else
             _xBoard++;
         return;
-    } else if (_xBoard >= 16 && _yBoard == 13 &&
+    } else if (_xBoard + depth >= xMax && tunnel &&
                (_lastDir == LEFT || _lastDir == NONE)) {
         _isInTunnel = true;
         // go back to house, keep his speed
@@ -514,7 +377,7 @@ void ghost::updateDir(
     }
 
     // if ghost is in some area, only left-right moves are allowed
-    if (_xBoard >= 8 && _xBoard <= 12 && (_yBoard == 10 || _yBoard == 20)) {
+    if (_level->isStraight(_xBoard, _yBoard)) {
         if (_lastDir == LEFT) {
             updateCoord();
             return;
@@ -547,20 +410,8 @@ void ghost::updateDir(
     }
     // scatter mode
     else if (_mode == SCATTER) {
-        switch (_color) {
-        case RED:
-            updateDirScatterMode(vecBoard, 19, 1);
-            break;
-        case PINK:
-            updateDirScatterMode(vecBoard, 1, 1);
-            break;
-        case BLUE:
-            updateDirScatterMode(vecBoard, 19, 25);
-            break;
-        case ORANGE:
-            updateDirScatterMode(vecBoard, 1, 25);
-            break;
-        }
+        Coordinate corner = _level->getScatter(_color);
+        updateDirScatterMode(vecBoard, corner.x, corner.y);
     }
     // frightened mode
     else if (_mode == FRIGHTENED)
@@ -570,48 +421,57 @@ void ghost::updateDir(
         _lastDir = NONE;
 }
 
-void ghost::updateDirRed(
-    std::vector<std::vector<std::shared_ptr<square>>> vecBoard, size_t xPac,
-    size_t yPac) {
+void ghost::updateDirRed(gridView vecBoard, size_t xPac, size_t yPac) {
+
+    dir nextDir = NONE;
+    const pathTable *paths = vecBoard.getPaths();
 
-    std::vector<std::shared_ptr<Node>> path;
+    if (paths != nullptr) {
+        // get the first direction of the precomputed shortest path to pacman
+        // without go back possibility
+        nextDir = paths->getNextDir(_xBoard, _yBoard, xPac, yPac, _lastDir);
 
-    if (_lastDir != NONE) {
+    } else {
+        std::vector<Node> path;
 
-        // new vecBoard without go back possibility
-        std::vector<std::vector<std::shared_ptr<square>>>
-            vecBoardWithoutGoBack =
+        if (_lastDir != NONE) {
+
+            // block the square behind to avoid go back possibility
+            BlockedSquares aboutTurn =
                 removeAboutTurn(vecBoard, _lastDir, _xBoard, _yBoard);
-        // get the shortest path to pacman
-        path = findShortestPath(vecBoardWithoutGoBack, _xBoard, _yBoard, xPac,
-                                yPac);
-    } else
-        path = findShortestPath(vecBoard, _xBoard, _yBoard, xPac, yPac);
+            // get the shortest path to pacman
+            path = findShortestPath(vecBoard, aboutTurn, _xBoard, _yBoard,
+                                    xPac, yPac);
+        } else
+            path = findShortestPath(vecBoard, _xBoard, _yBoard, xPac, yPac);
+
+        if (path.size() >= 2)
+            nextDir = findDir(path[0], path[1]);
+    }
 
     // if a shortest path is found, assign the new direction
-    if (path.size() >= 2) {
+    if (nextDir != NONE) {
 
-        _lastDir = findDir(path[0], path[1]);
+        _lastDir = nextDir;
         updateCoord();
     }
 
     else {
-        std::vector<dir> vecPossibleDir =
+        unsigned possibleDirs =
             findPossibleDir(vecBoard, _lastDir, LEFT, _xBoard, _yBoard);
 
-        if (vecPossibleDir.size() > 0) {
+        if (possibleDirs != 0) {
 
-            _lastDir = vecPossibleDir[std::uniform_int_distribution<size_t>(
-                0, vecPossibleDir.size() - 1)(_rng)];
+            int nbDirs = __builtin_popcount(possibleDirs);
+            _lastDir = nthDir(possibleDirs, _rng->bounded(nbDirs));
             updateCoord();
         } else
             _lastDir = NONE;
     }
 }
 
-void ghost::updateDirPink(
-    std::vector<std::vector<std::shared_ptr<square>>> vecBoard, size_t xPac,
-    size_t yPac, dir dirPac) {
+void ghost::updateDirPink(gridView vecBoard, size_t xPac, size_t yPac,
+                          dir dirPac) {
 
     // get the 4th square in front of pacman
     size_t xPac4 = xPac;
@@ -632,7 +492,7 @@ void ghost::updateDirPink(
             if (xPac4 == 0)
                 break;
 
-            if (vecBoard[xPac4 - 1][yPac4]->getState() == WALL) {
+            if (vecBoard.at(xPac4 - 1, yPac4).getState() == WALL) {
                 dist = 4;
                 break;
             }
@@ -640,10 +500,10 @@ void ghost::updateDirPink(
             break;
 
         case RIGHT:
-            if (xPac4 >= 20)
+            if (xPac4 >= vecBoard.getWidth() - 1)
                 break;
 
-            if (vecBoard[xPac4 + 1][yPac4]->getState() == WALL) {
+            if (vecBoard.at(xPac4 + 1, yPac4).getState() == WALL) {
                 dist = 4;
                 break;
             }
@@ -654,7 +514,7 @@ void ghost::updateDirPink(
             if (yPac4 == 0)
                 break;
 
-            if (vecBoard[xPac4][yPac4 - 1]->getState() == WALL) {
+            if (vecBoard.at(xPac4, yPac4 - 1).getState() == WALL) {
                 dist = 4;
                 break;
             }
@@ -662,10 +522,10 @@ void ghost::updateDirPink(
             break;
 
         case DOWN:
-            if (yPac4 >= 26)
+            if (yPac4 >= vecBoard.getHeight() - 1)
                 break;
 
-            if (vecBoard[xPac4][yPac4 + 1]->getState() == WALL) {
+            if (vecBoard.at(xPac4, yPac4 + 1).getState() == WALL) {
                 dist = 4;
                 break;
             }
@@ -678,38 +538,32 @@ void ghost::updateDirPink(
         dist++;
     }
 
-    // new vecBoard without go back possibility
-    std::vector<std::vector<std::shared_ptr<square>>> newVecBoard =
-        removeAboutTurn(vecBoard, _lastDir, _xBoard, _yBoard);
-
     // update direction with the shortest path to the 4th square in
-    // front of pacman
-    updateDirWithShortestPath(newVecBoard, xPac4, yPac4);
+    // front of pacman, without go back possibility
+    updateDirWithShortestPath(vecBoard, xPac4, yPac4);
 }
 
-void ghost::updateDirBlue(
-    std::vector<std::vector<std::shared_ptr<square>>> vecBoard, size_t xPac,
-    size_t yPac, dir dirPac) {
+void ghost::updateDirBlue(gridView vecBoard, size_t xPac, size_t yPac,
+                          dir dirPac) {
 
     // take red chase mode when leaving the house
     if (_blueRed == false && _bluePink == false) {
         _blueRed = true;
         updateDirRed(vecBoard, xPac, yPac);
-        blueTimer1 = std::chrono::steady_clock::now();
+        blueTimer1 = _clock->now();
         return;
     }
     // red chase mode
     else if (_blueRed == true && _bluePink == false) {
         // check if 20 seconds are spent
-        time_t blueTimer2 = std::chrono::steady_clock::now();
-        std::chrono::duration<double> elapsedTime = blueTimer2 - blueTimer1;
+        double elapsedTime = _clock->getElapsed(blueTimer1);
 
         // if 20 seconds are spent, take pink chase mode
-        if (elapsedTime.count() >= BLUE_GHOST_RED_TIME) {
+        if (elapsedTime >= BLUE_GHOST_RED_TIME) {
             _blueRed = false;
             _bluePink = true;
             updateDirPink(vecBoard, xPac, yPac, dirPac);
-            blueTimer1 = std::chrono::steady_clock::now();
+            blueTimer1 = _clock->now();
             return;
         }
 
@@ -720,15 +574,14 @@ void ghost::updateDirBlue(
     // pink chase mode
     else if (_blueRed == false && _bluePink == true) {
         // check if 12 seconds are spent
-        time_t blueTimer2 = std::chrono::steady_clock::now();
-        std::chrono::duration<double> elapsedTime = blueTimer2 - blueTimer1;
+        double elapsedTime = _clock->getElapsed(blueTimer1);
 
         // if 10 seconds are spent, take red chase mode
-        if (elapsedTime.count() >= BLUE_GHOST_PINK_TIME) {
+        if (elapsedTime >= BLUE_GHOST_PINK_TIME) {
             _bluePink = false;
             _blueRed = true;
             updateDirRed(vecBoard, xPac, yPac);
-            blueTimer1 = std::chrono::steady_clock::now();
+            blueTimer1 = _clock->now();
             return;
         }
 
@@ -738,22 +591,20 @@ void ghost::updateDirBlue(
     }
 
     else {
-        std::vector<dir> vecPossibleDir =
+        unsigned possibleDirs =
             findPossibleDir(vecBoard, _lastDir, LEFT, _xBoard, _yBoard);
 
-        if (vecPossibleDir.size() > 0) {
+        if (possibleDirs != 0) {
 
-            _lastDir = vecPossibleDir[std::uniform_int_distribution<size_t>(
-                0, vecPossibleDir.size() - 1)(_rng)];
+            int nbDirs = __builtin_popcount(possibleDirs);
+            _lastDir = nthDir(possibleDirs, _rng->bounded(nbDirs));
             updateCoord();
         } else
             _lastDir = NONE;
     }
 }
 
-void ghost::updateDirOrange(
-    std::vector<std::vector<std::shared_ptr<square>>> vecBoard, size_t xPac,
-    size_t yPac) {
+void ghost::updateDirOrange(gridView vecBoard, size_t xPac, size_t yPac) {
 
     // if ghost is at a distance greater than 8 go on pacman
     if (abs(_xBoard - xPac) + abs(_yBoard - yPac) > 8) {
@@ -766,16 +617,15 @@ void ghost::updateDirOrange(
         if (_mode != SCATTER) {
             _mode = SCATTER;
             _scatterHouse = false;
-            modeTimer1 = std::chrono::steady_clock::now();
+            modeTimer1 = _clock->now();
         }
-        updateDirScatterMode(vecBoard, 1, 25);
+        Coordinate corner = _level->getScatter(ORANGE);
+        updateDirScatterMode(vecBoard, corner.x, corner.y);
         return;
     }
 }
 
-void ghost::updateDirScatterMode(
-    std::vector<std::vector<std::shared_ptr<square>>> vecBoard, size_t x,
-    size_t y) {
+void ghost::updateDirScatterMode(gridView vecBoard, size_t x, size_t y) {
 
     // when arrive in the house, go back in chase mode
     if (_xBoard == x && _yBoard == y) {
@@ -783,42 +633,44 @@ void ghost::updateDirScatterMode(
         _scatterDir = _lastDir;
     }
 
+    // the patrols around the corners are the ones of the classic maze, the
+    // offsets are counted from the corner
     if (_scatterHouse == true) {
         // top left corner
         if (_color == PINK) {
             // arrive with left direction
             if (_scatterDir == LEFT) {
                 if (_lastDir == LEFT) {
-                    if (_xBoard == 1 && _yBoard == 1)
+                    if (_xBoard == x && _yBoard == y)
                         _lastDir = DOWN;
                 } else if (_lastDir == DOWN) {
-                    if (_xBoard == 1 && _yBoard == 5)
+                    if (_xBoard == x && _yBoard == y + 4)
                         _lastDir = RIGHT;
                 } else if (_lastDir == RIGHT) {
-                    if (_xBoard == 5 && _yBoard == 5)
+                    if (_xBoard == x + 4 && _yBoard == y + 4)
                         _lastDir = UP;
                 } else if (_lastDir == UP) {
-                    if (_xBoard == 5 && _yBoard == 1)
+                    if (_xBoard == x + 4 && _yBoard == y)
                         _lastDir = LEFT;
                 }
-                updateCoord();
+                patrol(vecBoard, x, y);
                 return;
 
             } else if (_scatterDir == UP) {
                 if (_lastDir == UP) {
-                    if (_xBoard == 1 && _yBoard == 1)
+                    if (_xBoard == x && _yBoard == y)
                         _lastDir = RIGHT;
                 } else if (_lastDir == RIGHT) {
-                    if (_xBoard == 5 && _yBoard == 1)
+                    if (_xBoard == x + 4 && _yBoard == y)
                         _lastDir = DOWN;
                 } else if (_lastDir == DOWN) {
-                    if (_xBoard == 5 && _yBoard == 5)
+                    if (_xBoard == x + 4 && _yBoard == y + 4)
                         _lastDir = LEFT;
                 } else if (_lastDir == LEFT) {
-                    if (_xBoard == 1 && _yBoard == 5)
+                    if (_xBoard == x && _yBoard == y + 4)
                         _lastDir = UP;
                 }
-                updateCoord();
+                patrol(vecBoard, x, y);
                 return;
             }
         }
@@ -827,36 +679,36 @@ void ghost::updateDirScatterMode(
             // arrive with right direction
             if (_scatterDir == RIGHT) {
                 if (_lastDir == RIGHT) {
-                    if (_xBoard == 19 && _yBoard == 1)
+                    if (_xBoard == x && _yBoard == y)
                         _lastDir = DOWN;
                 } else if (_lastDir == DOWN) {
-                    if (_xBoard == 19 && _yBoard == 5)
+                    if (_xBoard == x && _yBoard == y + 4)
                         _lastDir = LEFT;
                 } else if (_lastDir == LEFT) {
-                    if (_xBoard == 15 && _yBoard == 5)
+                    if (_xBoard == x - 4 && _yBoard == y + 4)
                         _lastDir = UP;
                 } else if (_lastDir == UP) {
-                    if (_xBoard == 15 && _yBoard == 1)
+                    if (_xBoard == x - 4 && _yBoard == y)
                         _lastDir = RIGHT;
                 }
-                updateCoord();
+                patrol(vecBoard, x, y);
                 return;
 
             } else if (_scatterDir == UP) {
                 if (_lastDir == UP) {
-                    if (_xBoard == 19 && _yBoard == 1)
+                    if (_xBoard == x && _yBoard == y)
                         _lastDir = LEFT;
                 } else if (_lastDir == LEFT) {
-                    if (_xBoard == 15 && _yBoard == 1)
+                    if (_xBoard == x - 4 && _yBoard == y)
                         _lastDir = DOWN;
                 } else if (_lastDir == DOWN) {
-                    if (_xBoard == 15 && _yBoard == 5)
+                    if (_xBoard == x - 4 && _yBoard == y + 4)
                         _lastDir = RIGHT;
                 } else if (_lastDir == RIGHT) {
-                    if (_xBoard == 19 && _yBoard == 5)
+                    if (_xBoard == x && _yBoard == y + 4)
                         _lastDir = UP;
                 }
-                updateCoord();
+                patrol(vecBoard, x, y);
                 return;
             }
         }
@@ -865,58 +717,58 @@ void ghost::updateDirScatterMode(
             // arrive with left direction
             if (_scatterDir == LEFT) {
                 if (_lastDir == LEFT) {
-                    if (_xBoard == 1 && _yBoard == 25)
+                    if (_xBoard == x && _yBoard == y)
                         _lastDir = UP;
                 } else if (_lastDir == UP) {
-                    if (_xBoard == 1 && _yBoard == 23)
+                    if (_xBoard == x && _yBoard == y - 2)
                         _lastDir = RIGHT;
-                    else if (_xBoard == 5 && _yBoard == 20)
+                    else if (_xBoard == x + 4 && _yBoard == y - 5)
                         _lastDir = RIGHT;
-                    else if (_xBoard == 9 && _yBoard == 23)
+                    else if (_xBoard == x + 8 && _yBoard == y - 2)
                         _lastDir = DOWN;
                 } else if (_lastDir == RIGHT) {
-                    if (_xBoard == 5 && _yBoard == 23)
+                    if (_xBoard == x + 4 && _yBoard == y - 2)
                         _lastDir = UP;
-                    else if (_xBoard == 7 && _yBoard == 20)
+                    else if (_xBoard == x + 6 && _yBoard == y - 5)
                         _lastDir = DOWN;
-                    else if (_xBoard == 9 && _yBoard == 23)
+                    else if (_xBoard == x + 8 && _yBoard == y - 2)
                         _lastDir = DOWN;
                 } else if (_lastDir == DOWN) {
-                    if (_xBoard == 7 && _yBoard == 23)
+                    if (_xBoard == x + 6 && _yBoard == y - 2)
                         _lastDir = RIGHT;
-                    else if (_xBoard == 9 && _yBoard == 25)
+                    else if (_xBoard == x + 8 && _yBoard == y)
                         _lastDir = LEFT;
                 }
-                updateCoord();
+                patrol(vecBoard, x, y);
                 return;
 
             } else if (_scatterDir == DOWN) {
                 if (_lastDir == DOWN) {
-                    if (_xBoard == 1 && _yBoard == 25)
+                    if (_xBoard == x && _yBoard == y)
                         _lastDir = RIGHT;
-                    else if (_xBoard == 5 && _yBoard == 23)
+                    else if (_xBoard == x + 4 && _yBoard == y - 2)
                         _lastDir = LEFT;
                 } else if (_lastDir == RIGHT) {
-                    if (_xBoard == 9 && _yBoard == 25)
+                    if (_xBoard == x + 8 && _yBoard == y)
                         _lastDir = UP;
-                    else if (_xBoard == 7 && _yBoard == 20)
+                    else if (_xBoard == x + 6 && _yBoard == y - 5)
                         _lastDir = LEFT;
-                    else if (_xBoard == 5 && _yBoard == 23)
+                    else if (_xBoard == x + 4 && _yBoard == y - 2)
                         _lastDir = LEFT;
                 } else if (_lastDir == UP) {
-                    if (_xBoard == 9 && _yBoard == 23)
+                    if (_xBoard == x + 8 && _yBoard == y - 2)
                         _lastDir = LEFT;
-                    else if (_xBoard == 7 && _yBoard == 20)
+                    else if (_xBoard == x + 6 && _yBoard == y - 5)
                         _lastDir = LEFT;
                 } else if (_lastDir == LEFT) {
-                    if (_xBoard == 7 && _yBoard == 23)
+                    if (_xBoard == x + 6 && _yBoard == y - 2)
                         _lastDir = UP;
-                    else if (_xBoard == 5 && _yBoard == 20)
+                    else if (_xBoard == x + 4 && _yBoard == y - 5)
                         _lastDir = DOWN;
-                    else if (_xBoard == 1 && _yBoard == 23)
+                    else if (_xBoard == x && _yBoard == y - 2)
                         _lastDir = DOWN;
                 }
-                updateCoord();
+                patrol(vecBoard, x, y);
                 return;
             }
         }
@@ -925,58 +777,58 @@ void ghost::updateDirScatterMode(
             // arrive with right direction
             if (_scatterDir == RIGHT) {
                 if (_lastDir == RIGHT) {
-                    if (_xBoard == 19 && _yBoard == 25)
+                    if (_xBoard == x && _yBoard == y)
                         _lastDir = UP;
                 } else if (_lastDir == UP) {
-                    if (_xBoard == 19 && _yBoard == 23)
+                    if (_xBoard == x && _yBoard == y - 2)
                         _lastDir = LEFT;
-                    else if (_xBoard == 15 && _yBoard == 20)
+                    else if (_xBoard == x - 4 && _yBoard == y - 5)
                         _lastDir = LEFT;
-                    else if (_xBoard == 11 && _yBoard == 23)
+                    else if (_xBoard == x - 8 && _yBoard == y - 2)
                         _lastDir = DOWN;
                 } else if (_lastDir == LEFT) {
-                    if (_xBoard == 15 && _yBoard == 23)
+                    if (_xBoard == x - 4 && _yBoard == y - 2)
                         _lastDir = UP;
-                    else if (_xBoard == 13 && _yBoard == 20)
+                    else if (_xBoard == x - 6 && _yBoard == y - 5)
                         _lastDir = DOWN;
-                    else if (_xBoard == 11 && _yBoard == 23)
+                    else if (_xBoard == x - 8 && _yBoard == y - 2)
                         _lastDir = DOWN;
                 } else if (_lastDir == DOWN) {
-                    if (_xBoard == 13 && _yBoard == 23)
+                    if (_xBoard == x - 6 && _yBoard == y - 2)
                         _lastDir = LEFT;
-                    else if (_xBoard == 11 && _yBoard == 25)
+                    else if (_xBoard == x - 8 && _yBoard == y)
                         _lastDir = RIGHT;
                 }
-                updateCoord();
+                patrol(vecBoard, x, y);
                 return;
 
             } else if (_scatterDir == DOWN) {
                 if (_lastDir == DOWN) {
-                    if (_xBoard == 19 && _yBoard == 25)
+                    if (_xBoard == x && _yBoard == y)
                         _lastDir = LEFT;
-                    else if (_xBoard == 15 && _yBoard == 23)
+                    else if (_xBoard == x - 4 && _yBoard == y - 2)
                         _lastDir = RIGHT;
                 } else if (_lastDir == LEFT) {
-                    if (_xBoard == 11 && _yBoard == 25)
+                    if (_xBoard == x - 8 && _yBoard == y)
                         _lastDir = UP;
-                    else if (_xBoard == 13 && _yBoard == 20)
+                    else if (_xBoard == x - 6 && _yBoard == y - 5)
                         _lastDir = RIGHT;
-                    else if (_xBoard == 15 && _yBoard == 23)
+                    else if (_xBoard == x - 4 && _yBoard == y - 2)
                         _lastDir = RIGHT;
                 } else if (_lastDir == UP) {
-                    if (_xBoard == 11 && _yBoard == 23)
+                    if (_xBoard == x - 8 && _yBoard == y - 2)
                         _lastDir = RIGHT;
-                    else if (_xBoard == 13 && _yBoard == 20)
+                    else if (_xBoard == x - 6 && _yBoard == y - 5)
                         _lastDir = RIGHT;
                 } else if (_lastDir == RIGHT) {
-                    if (_xBoard == 13 && _yBoard == 23)
+                    if (_xBoard == x - 6 && _yBoard == y - 2)
                         _lastDir = UP;
-                    else if (_xBoard == 15 && _yBoard == 20)
+                    else if (_xBoard == x - 4 && _yBoard == y - 5)
                         _lastDir = DOWN;
-                    else if (_xBoard == 19 && _yBoard == 23)
+                    else if (_xBoard == x && _yBoard == y - 2)
                         _lastDir = DOWN;
                 }
-                updateCoord();
+                patrol(vecBoard, x, y);
                 return;
             }
         }
@@ -984,18 +836,32 @@ void ghost::updateDirScatterMode(
         updateDirWithShortestPath(vecBoard, x, y);
 }
 
-void ghost::updateDirRunAwayMode(
-    std::vector<std::vector<std::shared_ptr<square>>> vecBoard) {
+void ghost::patrol(gridView vecBoard, size_t x, size_t y) {
+
+    size_t xNext = _xBoard + (_lastDir == RIGHT) - (_lastDir == LEFT);
+    size_t yNext = _yBoard + (_lastDir == DOWN) - (_lastDir == UP);
+
+    // on another maze, go back to the corner when the patrol meets a wall
+    if (!vecBoard.isInside(xNext, yNext) ||
+        vecBoard.at(xNext, yNext).getState() != HALL) {
+        _scatterHouse = false;
+        updateDirWithShortestPath(vecBoard, x, y);
+        return;
+    }
+    updateCoord();
+}
+
+void ghost::updateDirRunAwayMode(gridView vecBoard) {
 
     // find all the possible directions with avoiding last direction
-    std::vector<dir> vecPossibleDir =
+    unsigned possibleDirs =
         findPossibleDir(vecBoard, _lastDir, NONE, _xBoard, _yBoard);
 
-    if (vecPossibleDir.size() > 0) {
+    if (possibleDirs != 0) {
 
         // take a random direction among the possible ones
-        _lastDir = vecPossibleDir[std::uniform_int_distribution<size_t>(
-            0, vecPossibleDir.size() - 1)(_rng)];
+        int nbDirs = __builtin_popcount(possibleDirs);
+        _lastDir = nthDir(possibleDirs, _rng->bounded(nbDirs));
         updateCoord();
     }
 
@@ -1005,53 +871,52 @@ void ghost::updateDirRunAwayMode(
 
 void ghost::swapMode(int level) {
 
-    time_t modeTimer2 = std::chrono::steady_clock::now();
-    std::chrono::duration<double> elapsedTime = modeTimer2 - modeTimer1;
+    double elapsedTime = _clock->getElapsed(modeTimer1);
 
     if (_mode == ANY) {
         _mode = SCATTER;
         _scatterHouse = false;
-        modeTimer1 = std::chrono::steady_clock::now();
+        modeTimer1 = _clock->now();
 
     } else if (_mode == CHASE) {
 
         if ((level == 1 && _swapMode < 4) || (level >= 2 && _swapMode < 3)) {
-            if (elapsedTime.count() >= CHASE_MODE) {
+            if (elapsedTime >= CHASE_MODE) {
                 _lastDir = NONE;
                 _mode = SCATTER;
                 _scatterHouse = false;
-                modeTimer1 = std::chrono::steady_clock::now();
+                modeTimer1 = _clock->now();
             }
         }
     } else if (_mode == SCATTER) {
 
         if (level == 1) {
 
-            if (elapsedTime.count() >= SCATTER_MODE_1) {
+            if (elapsedTime >= SCATTER_MODE_1) {
                 _lastDir = NONE;
                 _scatterHouse = false;
                 _mode = CHASE;
                 _swapMode++;
-                modeTimer1 = std::chrono::steady_clock::now();
+                modeTimer1 = _clock->now();
             }
         } else if ((level >= 2 && level <= 4) || _color == ORANGE) {
 
-            if ((_swapMode <= 1 && elapsedTime.count() >= SCATTER_MODE_1) ||
-                (_swapMode == 2 && elapsedTime.count() >= SCATTER_MODE_2)) {
+            if ((_swapMode <= 1 && elapsedTime >= SCATTER_MODE_1) ||
+                (_swapMode == 2 && elapsedTime >= SCATTER_MODE_2)) {
                 _lastDir = NONE;
                 _scatterHouse = false;
                 _mode = CHASE;
                 _swapMode++;
-                modeTimer1 = std::chrono::steady_clock::now();
+                modeTimer1 = _clock->now();
             }
         } else if (level > 4 || _color == ORANGE) {
 
-            if (elapsedTime.count() >= SCATTER_MODE_2) {
+            if (elapsedTime >= SCATTER_MODE_2) {
                 _lastDir = NONE;
                 _scatterHouse = false;
                 _mode = CHASE;
                 _swapMode++;
-                modeTimer1 = std::chrono::steady_clock::now();
+                modeTimer1 = _clock->now();
             }
         }
     }
@@ -0,0 +1,296 @@
+#include "ghostpack.h"
+
+// move of one pixel in each direction
+static const int dirX[5] = {-1, 1, 0, 0, 0};
+static const int dirY[5] = {0, 0, -1, 1, 0};
+
+// speed of the move in function of the speed state: slow when the ghost is
+// frightened, in the tunnel or in the house, fast when it returns to the
+// house, and no move for the states which are not handled
+static const uint8_t moveSpeed[NB_GHOST_STATES] = {
+    GHOST_SPEED,        // nothing
+    GHOST_SLOW_SPEED,   // fear
+    GHOST_RETURN_SPEED, // return
+    0,                  // fear, return
+    GHOST_SLOW_SPEED,   // house
+    GHOST_SLOW_SPEED,   // fear, house
+    0,                  // return, house
+    0,                  // fear, return, house
+    GHOST_SLOW_SPEED,   // tunnel
+    GHOST_SLOW_SPEED,   // fear, tunnel
+    0,                  // return, tunnel
+    0,                  // fear, return, tunnel
+    GHOST_SLOW_SPEED,   // house, tunnel
+    GHOST_SLOW_SPEED,   // fear, house, tunnel
+    0,                  // return, house, tunnel
+    0,                  // fear, return, house, tunnel
+};
+
+// speed used to detect the center of a square, the ghosts in the house are
+// treated as the ones at normal speed
+static const uint8_t centerSpeed[NB_GHOST_STATES] = {
+    GHOST_SPEED,        // nothing
+    GHOST_SLOW_SPEED,   // fear
+    GHOST_RETURN_SPEED, // return
+    GHOST_SPEED,        // fear, return
+    GHOST_SPEED,        // house
+    GHOST_SPEED,        // fear, house
+    GHOST_SPEED,        // return, house
+    GHOST_SPEED,        // fear, return, house
+    GHOST_SLOW_SPEED,   // tunnel
+    GHOST_SLOW_SPEED,   // fear, tunnel
+    GHOST_RETURN_SPEED, // return, tunnel
+    GHOST_SPEED,        // fear, return, tunnel
+    GHOST_SPEED,        // house, tunnel
+    GHOST_SPEED,        // fear, house, tunnel
+    GHOST_SPEED,        // return, house, tunnel
+    GHOST_SPEED,        // fear, return, house, tunnel
+};
+
+ghostPack::ghostPack(const gameClock &clock, const level &Level,
+                     rng &random) {
+    _clock = &clock;
+    _level = &Level;
+    _rng = &random;
+}
+
+ghostPack::ghostPack(const ghostPack &other) { *this = other; }
+
+ghostPack &ghostPack::operator=(const ghostPack &other) {
+    _clock = other._clock;
+    _level = other._level;
+    _rng = other._rng;
+    _vecGhost = other._vecGhost;
+    _xPixel = other._xPixel;
+    _yPixel = other._yPixel;
+    _xCenter = other._xCenter;
+    _yCenter = other._yCenter;
+    _dir = other._dir;
+    _state = other._state;
+    _atCenter = other._atCenter;
+    _contact = other._contact;
+    bind();
+    return *this;
+}
+
+ghostPack::~ghostPack() {}
+
+void ghostPack::bind() {
+    for (auto &Ghost : _vecGhost)
+        Ghost._pack = this;
+}
+
+void ghostPack::reset(size_t nbGhosts) {
+
+    _xPixel.assign(nbGhosts, 0);
+    _yPixel.assign(nbGhosts, 0);
+    _xCenter.assign(nbGhosts, 0);
+    _yCenter.assign(nbGhosts, 0);
+    _dir.assign(nbGhosts, NONE);
+    _state.assign(nbGhosts, 0);
+    _atCenter.assign(nbGhosts, 0);
+    _contact.assign(nbGhosts, 0);
+
+    _vecGhost.clear();
+    for (size_t i = 0; i < nbGhosts; i++)
+        _vecGhost.push_back(ghost(*this, i, *_clock, *_level, *_rng));
+    for (size_t i = 0; i < nbGhosts; i++) {
+        _vecGhost[i].setGhost(color(i % NB_COLORS));
+        sync(i);
+    }
+}
+
+void ghostPack::sync(size_t i) {
+
+    ghost &Ghost = _vecGhost[i];
+    _xCenter[i] = Ghost._xBoard * SCALE_PIXEL + GHOST_CENTER_X;
+    _yCenter[i] = Ghost._yBoard * SCALE_PIXEL + GHOST_CENTER_Y;
+    _dir[i] = Ghost._lastDir;
+    _state[i] = Ghost._isFear * GHOST_STATE_FEAR |
+                Ghost._isReturnHouse * GHOST_STATE_RETURN |
+                Ghost._isInHouse * GHOST_STATE_HOUSE |
+                Ghost._isInTunnel * GHOST_STATE_TUNNEL;
+}
+
+void ghostPack::waitSquareCenter() {
+
+    for (size_t i = 0; i < _vecGhost.size(); i++) {
+
+        size_t speed = centerSpeed[_state[i]], range = speed - 1;
+        size_t x = _xPixel[i], y = _yPixel[i];
+        bool center = false;
+        switch (_dir[i]) {
+        case LEFT:
+            center = x - speed <= _xCenter[i] + range;
+            break;
+        case RIGHT:
+            center = x + speed >= _xCenter[i] - range;
+            break;
+        case UP:
+            center = y + speed <= _yCenter[i] + range;
+            break;
+        case DOWN:
+            center = y + speed >= _yCenter[i] - range;
+            break;
+        case NONE:
+            center = true;
+            break;
+        }
+
+        // move the ghost to the center of the square
+        _xPixel[i] = center && dirX[_dir[i]] != 0 ? _xCenter[i] : x;
+        _yPixel[i] = center && dirY[_dir[i]] != 0 ? _yCenter[i] : y;
+        _atCenter[i] = center;
+    }
+}
+
+void ghostPack::updateDir(gridView vecBoard, size_t xPac, size_t yPac,
+                          dir dirPac, int level, int dotCounter, int life,
+                          tick_t noEatenDotTimer1) {
+
+    for (size_t i = 0; i < _vecGhost.size(); i++) {
+        if (_atCenter[i])
+            updateDir(i, vecBoard, xPac, yPac, dirPac, level, dotCounter,
+                      life, noEatenDotTimer1);
+    }
+}
+
+void ghostPack::updateDir(size_t i, gridView vecBoard, size_t xPac,
+                          size_t yPac, dir dirPac, int level, int dotCounter,
+                          int life, tick_t noEatenDotTimer1) {
+    _vecGhost[i].updateDir(vecBoard, xPac, yPac, dirPac, level, dotCounter,
+                           life, noEatenDotTimer1);
+    sync(i);
+}
+
+void ghostPack::updatePos() {
+    for (size_t i = 0; i < _vecGhost.size(); i++) {
+        int speed = moveSpeed[_state[i]];
+        _xPixel[i] += dirX[_dir[i]] * speed;
+        _yPixel[i] += dirY[_dir[i]] * speed;
+    }
+}
+
+void ghostPack::setFrightened(bool isFear) {
+    for (size_t i = 0; i < _vecGhost.size(); i++) {
+        if (_vecGhost[i].isInHouse() == false) {
+            _vecGhost[i].setFrightened(isFear);
+            sync(i);
+        }
+    }
+}
+
+void ghostPack::setReturnHouse(size_t i) {
+    _vecGhost[i].setReturnHouse();
+    sync(i);
+}
+
+const std::vector<uint8_t> &ghostPack::findContact(size_t x, size_t y,
+                                                   int contact) {
+    for (size_t i = 0; i < _vecGhost.size(); i++)
+        _contact[i] = abs(x - _xPixel[i]) < contact &&
+                      abs(y - _yPixel[i]) < contact;
+    return _contact;
+}
+
+void ghostPack::save(GhostState *states) const {
+
+    for (size_t i = 0; i < _vecGhost.size(); i++) {
+        const ghost &Ghost = _vecGhost[i];
+        GhostState &state = states[i];
+        state = GhostState();
+        state.xBoard = Ghost._xBoard;
+        state.yBoard = Ghost._yBoard;
+        state.xPixel = _xPixel[i];
+        state.yPixel = _yPixel[i];
+        state.xPixelEaten = Ghost._xPixelEaten;
+        state.yPixelEaten = Ghost._yPixelEaten;
+        state.modeTimer = Ghost.modeTimer1;
+        state.blueTimer = Ghost.blueTimer1;
+        state.swapMode = Ghost._swapMode;
+        state.color = Ghost._color;
+        state.lastDir = Ghost._lastDir;
+        state.mode = Ghost._mode;
+        state.scatterDir = Ghost._scatterDir;
+        state.scatterHouse = Ghost._scatterHouse;
+        state.chaseMode = Ghost._chaseMode;
+        state.scatterMode = Ghost._scatterMode;
+        state.frightenedMode = Ghost._frightenedMode;
+        state.isTime = Ghost._isTime;
+        state.isInHouse = Ghost._isInHouse;
+        state.isReturnHouse = Ghost._isReturnHouse;
+        state.isFear = Ghost._isFear;
+        state.isInTunnel = Ghost._isInTunnel;
+        state.blueRed = Ghost._blueRed;
+        state.bluePink = Ghost._bluePink;
+        state.atCenter = _atCenter[i];
+        state.contact = _contact[i];
+    }
+}
+
+void ghostPack::restore(const GhostState *states, size_t nbGhosts) {
+
+    if (nbGhosts != _vecGhost.size())
+        reset(nbGhosts);
+
+    for (size_t i = 0; i < nbGhosts; i++) {
+        ghost &Ghost = _vecGhost[i];
+        const GhostState &state = states[i];
+        Ghost._xBoard = state.xBoard;
+        Ghost._yBoard = state.yBoard;
+        _xPixel[i] = state.xPixel;
+        _yPixel[i] = state.yPixel;
+        Ghost._xPixelEaten = state.xPixelEaten;
+        Ghost._yPixelEaten = state.yPixelEaten;
+        Ghost.modeTimer1 = state.modeTimer;
+        Ghost.blueTimer1 = state.blueTimer;
+        Ghost._swapMode = state.swapMode;
+        Ghost._color = color(state.color);
+        Ghost._lastDir = dir(state.lastDir);
+        Ghost._mode = mode(state.mode);
+        Ghost._scatterDir = dir(state.scatterDir);
+        Ghost._scatterHouse = state.scatterHouse;
+        Ghost._chaseMode = state.chaseMode;
+        Ghost._scatterMode = state.scatterMode;
+        Ghost._frightenedMode = state.frightenedMode;
+        Ghost._isTime = state.isTime;
+        Ghost._isInHouse = state.isInHouse;
+        Ghost._isReturnHouse = state.isReturnHouse;
+        Ghost._isFear = state.isFear;
+        Ghost._isInTunnel = state.isInTunnel;
+        Ghost._blueRed = state.blueRed;
+        Ghost._bluePink = state.bluePink;
+        _atCenter[i] = state.atCenter;
+        _contact[i] = state.contact;
+        sync(i);
+    }
+}
+
+uint64_t ghostPack::getHash() const {
+
+    uint64_t hash = 0;
+    for (size_t i = 0; i < _vecGhost.size(); i++) {
+        const ghost &Ghost = _vecGhost[i];
+        uint64_t flags =
+            Ghost._scatterHouse | Ghost._chaseMode << 1 |
+            Ghost._scatterMode << 2 | Ghost._frightenedMode << 3 |
+            Ghost._isTime << 4 | Ghost._isInHouse << 5 |
+            Ghost._isReturnHouse << 6 | Ghost._isFear << 7 |
+            Ghost._isInTunnel << 8 | Ghost._blueRed << 9 |
+            Ghost._bluePink << 10 | _atCenter[i] << 11 | _contact[i] << 12;
+        hash ^= zobristHasher(ZOBRIST_GHOST, i)
+                    .add(_xPixel[i])
+                    .add(_yPixel[i])
+                    .add(Ghost._xBoard | uint64_t(Ghost._yBoard) << 32)
+                    .add(Ghost._xPixelEaten |
+                         uint64_t(Ghost._yPixelEaten) << 32)
+                    .add(Ghost._color | Ghost._lastDir << 8 |
+                         Ghost._mode << 16 | Ghost._scatterDir << 24 |
+                         uint64_t(uint32_t(Ghost._swapMode)) << 32)
+                    .add(flags)
+                    .add(Ghost.modeTimer1)
+                    .add(Ghost.blueTimer1)
+                    .get();
+    }
+    return hash;
+}
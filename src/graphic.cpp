@@ -1,29 +1,25 @@
 #include "graphic.h"
 
-SDL_Rect src_bg = {370, 3, 168, 216};
-SDL_Rect bg = {4, 4 + SCORE_HEADER, 672, 864};
+const SDL_Rect src_bg = {370, 3, 168, 216};
+const SDL_Rect bg = {4, 4 + SCORE_HEADER, 672, 864};
 
 // Pacman logo
-SDL_Rect pacmanLogo = {3, 3, 182, 49};
+const SDL_Rect pacmanLogo = {3, 3, 182, 49};
 
 // PacMan
 // animation
-SDL_Rect pac_blank = {3, 89, 16, 16};
-SDL_Rect pac_r = {20, 89, 16, 16};
-SDL_Rect pac_l = {46, 89, 16, 16};
-SDL_Rect pac_d = {109, 90, 16, 16};
-SDL_Rect pac_u = {75, 89, 16, 16};
-// position
-SDL_Rect _pacman = {PACMAN_INIT_X * SCALE_PIXEL + PACMAN_CENTER_X,
-                    PACMAN_INIT_Y *SCALE_PIXEL + PACMAN_CENTER_Y, SCALE_PIXEL,
-                    SCALE_PIXEL};
+const SDL_Rect pac_blank = {3, 89, 16, 16};
+const SDL_Rect pac_r = {20, 89, 16, 16};
+const SDL_Rect pac_l = {46, 89, 16, 16};
+const SDL_Rect pac_d = {109, 90, 16, 16};
+const SDL_Rect pac_u = {75, 89, 16, 16};
 // eaten
-std::vector<SDL_Rect> eatenPacman{
+const std::vector<SDL_Rect> eatenPacman{
     {3, 110, 17, 10}, {22, 112, 18, 8}, {41, 113, 18, 7},
     {79, 112, 18, 8}, {98, 111, 16, 9}, {115, 111, 12, 9},
     {128, 111, 8, 9}, {137, 111, 4, 9}, {142, 108, 12, 12}};
 // life
-SDL_Rect _life = {168, 75, 12, 14};
+const SDL_Rect _life = {168, 75, 12, 14};
 
 // Ghost
 std::vector<std::vector<SDL_Rect>> initGhostSrpite() {
@@ -35,10 +31,6 @@ std::vector<std::vector<SDL_Rect>> initGhostSrpite() {
     redGhostSprite.push_back({3, 123, 16, 16});   // right
     redGhostSprite.push_back({71, 123, 16, 16});  // up
     redGhostSprite.push_back({105, 123, 16, 16}); // down
-    // position
-    redGhostSprite.push_back({RED_GHOST_INIT_X * SCALE_PIXEL + GHOST_CENTER_X,
-                              RED_GHOST_INIT_Y * SCALE_PIXEL + GHOST_CENTER_Y,
-                              SCALE_PIXEL, SCALE_PIXEL});
 
     // Pink Ghost
     std::vector<SDL_Rect> pinkGhostSprite;
@@ -47,10 +39,6 @@ std::vector<std::vector<SDL_Rect>> initGhostSrpite() {
     pinkGhostSprite.push_back({3, 141, 16, 16});
     pinkGhostSprite.push_back({71, 141, 16, 16});
     pinkGhostSprite.push_back({105, 141, 16, 16});
-    // position
-    pinkGhostSprite.push_back({PINK_GHOST_INIT_X * SCALE_PIXEL + GHOST_CENTER_X,
-                               PINK_GHOST_INIT_Y * SCALE_PIXEL + GHOST_CENTER_Y,
-                               SCALE_PIXEL, SCALE_PIXEL});
 
     // Blue Ghost
     std::vector<SDL_Rect> blueGhostSprite;
@@ -59,10 +47,6 @@ std::vector<std::vector<SDL_Rect>> initGhostSrpite() {
     blueGhostSprite.push_back({3, 159, 16, 16});
     blueGhostSprite.push_back({71, 159, 16, 16});
     blueGhostSprite.push_back({105, 159, 16, 16});
-    // position
-    blueGhostSprite.push_back({BLUE_GHOST_INIT_X * SCALE_PIXEL + GHOST_CENTER_X,
-                               BLUE_GHOST_INIT_Y * SCALE_PIXEL + GHOST_CENTER_Y,
-                               SCALE_PIXEL, SCALE_PIXEL});
     // Orange Ghost
     std::vector<SDL_Rect> orangeGhostSprite;
     // animation
@@ -70,11 +54,6 @@ std::vector<std::vector<SDL_Rect>> initGhostSrpite() {
     orangeGhostSprite.push_back({3, 177, 16, 16});
     orangeGhostSprite.push_back({71, 177, 16, 16});
     orangeGhostSprite.push_back({105, 177, 16, 16});
-    // position
-    orangeGhostSprite.push_back(
-        {ORANGE_GHOST_INIT_X * SCALE_PIXEL + GHOST_CENTER_X,
-         ORANGE_GHOST_INIT_Y * SCALE_PIXEL + GHOST_CENTER_Y, SCALE_PIXEL,
-         SCALE_PIXEL});
 
     std::vector<std::vector<SDL_Rect>> vecGhostSprite;
     vecGhostSprite.push_back(redGhostSprite);
@@ -85,93 +64,93 @@ std::vector<std::vector<SDL_Rect>> initGhostSrpite() {
     return vecGhostSprite;
 }
 
-SDL_Rect fearBlueGhostSprite{3, 195, 16, 16};
-SDL_Rect fearWhiteGhostSprite{37, 195, 16, 16};
-SDL_Rect eatenGhostSprite_r{71, 195, 16, 16};
-SDL_Rect eatenGhostSprite_l{88, 195, 16, 16};
-SDL_Rect eatenGhostSprite_u{105, 195, 16, 16};
-SDL_Rect eatenGhostSprite_d{122, 195, 16, 16};
+const SDL_Rect fearBlueGhostSprite{3, 195, 16, 16};
+const SDL_Rect fearWhiteGhostSprite{37, 195, 16, 16};
+const SDL_Rect eatenGhostSprite_r{71, 195, 16, 16};
+const SDL_Rect eatenGhostSprite_l{88, 195, 16, 16};
+const SDL_Rect eatenGhostSprite_u{105, 195, 16, 16};
+const SDL_Rect eatenGhostSprite_d{122, 195, 16, 16};
 
-std::vector<std::vector<SDL_Rect>> vecGhostSprite = initGhostSrpite();
+const std::vector<std::vector<SDL_Rect>> vecGhostSprite = initGhostSrpite();
 
 // items
-SDL_Rect dot_in = {4, 81, 2, 2};
-SDL_Rect powerup_in = {9, 79, 7, 7};
-SDL_Rect cherry_in = {289, 236, 14, 14};
-SDL_Rect strawberry_in = {305, 236, 14, 14};
-SDL_Rect orange_in = {320, 236, 14, 14};
-SDL_Rect apple_in = {337, 236, 14, 14};
-SDL_Rect melon_in = {352, 234, 14, 16};
-SDL_Rect galaxian_in = {369, 235, 14, 14};
-SDL_Rect bell_in = {385, 235, 16, 16};
-SDL_Rect key_in = {400, 235, 14, 16};
+const SDL_Rect dot_in = {4, 81, 2, 2};
+const SDL_Rect powerup_in = {9, 79, 7, 7};
+const SDL_Rect cherry_in = {289, 236, 14, 14};
+const SDL_Rect strawberry_in = {305, 236, 14, 14};
+const SDL_Rect orange_in = {320, 236, 14, 14};
+const SDL_Rect apple_in = {337, 236, 14, 14};
+const SDL_Rect melon_in = {352, 234, 14, 16};
+const SDL_Rect galaxian_in = {369, 235, 14, 14};
+const SDL_Rect bell_in = {385, 235, 16, 16};
+const SDL_Rect key_in = {400, 235, 14, 16};
 
 // Vector of fruits
-std::vector<SDL_Rect> vecFruitSprite = {cherry_in, strawberry_in, orange_in,
-                                        apple_in,  melon_in,      galaxian_in,
-                                        bell_in,   key_in};
+const std::vector<SDL_Rect> vecFruitSprite = {
+    cherry_in, strawberry_in, orange_in, apple_in,
+    melon_in,  galaxian_in,   bell_in,   key_in};
 
 // Score
-SDL_Rect score100 = {180, 133, 13, 7};
-SDL_Rect score300 = {179, 142, 14, 7};
-SDL_Rect score500 = {179, 151, 14, 7};
-SDL_Rect score700 = {179, 160, 14, 7};
-SDL_Rect score1000 = {177, 169, 16, 7};
-SDL_Rect score2000 = {177, 178, 16, 7};
-SDL_Rect score3000 = {177, 187, 16, 7};
-SDL_Rect score5000 = {177, 196, 16, 7};
-SDL_Rect score200 = {155, 176, 14, 7};
-SDL_Rect score400 = {155, 185, 14, 7};
-SDL_Rect score800 = {155, 194, 14, 7};
-SDL_Rect score1600 = {154, 203, 15, 7};
-SDL_Rect pts = {177, 204, 16, 7};
-std::map<int, SDL_Rect> scoreSprite = {
+const SDL_Rect score100 = {180, 133, 13, 7};
+const SDL_Rect score300 = {179, 142, 14, 7};
+const SDL_Rect score500 = {179, 151, 14, 7};
+const SDL_Rect score700 = {179, 160, 14, 7};
+const SDL_Rect score1000 = {177, 169, 16, 7};
+const SDL_Rect score2000 = {177, 178, 16, 7};
+const SDL_Rect score3000 = {177, 187, 16, 7};
+const SDL_Rect score5000 = {177, 196, 16, 7};
+const SDL_Rect score200 = {155, 176, 14, 7};
+const SDL_Rect score400 = {155, 185, 14, 7};
+const SDL_Rect score800 = {155, 194, 14, 7};
+const SDL_Rect score1600 = {154, 203, 15, 7};
+const SDL_Rect pts = {177, 204, 16, 7};
+const std::map<int, SDL_Rect> scoreSprite = {
     {100, score100},   {300, score300},   {500, score500},   {700, score700},
     {1000, score1000}, {2000, score2000}, {3000, score3000}, {5000, score5000},
     {200, score200},   {400, score400},   {800, score800},   {1600, score1600}};
 
 // Letters and numbers for SDL
-SDL_Rect letter_a = {12, 61, 8, 8};
-SDL_Rect letter_b = {20, 61, 8, 8};
-SDL_Rect letter_c = {28, 61, 8, 8};
-SDL_Rect letter_d = {36, 61, 8, 8};
-SDL_Rect letter_e = {44, 61, 8, 8};
-SDL_Rect letter_f = {52, 61, 8, 8};
-SDL_Rect letter_g = {60, 61, 8, 8};
-SDL_Rect letter_h = {68, 61, 8, 8};
-SDL_Rect letter_i = {76, 61, 8, 8};
-SDL_Rect letter_j = {84, 61, 8, 8};
-SDL_Rect letter_k = {92, 61, 8, 8};
-SDL_Rect letter_l = {100, 61, 8, 8};
-SDL_Rect letter_m = {108, 61, 8, 8};
-SDL_Rect letter_n = {116, 61, 8, 8};
-SDL_Rect letter_o = {124, 61, 8, 8};
-SDL_Rect letter_p = {4, 69, 8, 8};
-SDL_Rect letter_q = {12, 69, 8, 8};
-SDL_Rect letter_r = {20, 69, 8, 8};
-SDL_Rect letter_s = {28, 69, 8, 8};
-SDL_Rect letter_t = {36, 69, 8, 8};
-SDL_Rect letter_u = {44, 69, 8, 8};
-SDL_Rect letter_v = {52, 69, 8, 8};
-SDL_Rect letter_w = {60, 69, 8, 8};
-SDL_Rect letter_x = {68, 69, 8, 8};
-SDL_Rect letter_y = {76, 69, 8, 8};
-SDL_Rect letter_z = {84, 69, 8, 8};
-SDL_Rect letter_point = {92, 69, 8, 8};
-SDL_Rect letter_0 = {4, 53, 8, 8};
-SDL_Rect letter_1 = {12, 53, 8, 8};
-SDL_Rect letter_2 = {20, 53, 8, 8};
-SDL_Rect letter_3 = {28, 53, 8, 8};
-SDL_Rect letter_4 = {36, 53, 8, 8};
-SDL_Rect letter_5 = {44, 53, 8, 8};
-SDL_Rect letter_6 = {52, 53, 8, 8};
-SDL_Rect letter_7 = {60, 53, 8, 8};
-SDL_Rect letter_8 = {68, 53, 8, 8};
-SDL_Rect letter_9 = {76, 53, 8, 8};
-SDL_Rect letter_blank = {108, 69, 8, 8};
+const SDL_Rect letter_a = {12, 61, 8, 8};
+const SDL_Rect letter_b = {20, 61, 8, 8};
+const SDL_Rect letter_c = {28, 61, 8, 8};
+const SDL_Rect letter_d = {36, 61, 8, 8};
+const SDL_Rect letter_e = {44, 61, 8, 8};
+const SDL_Rect letter_f = {52, 61, 8, 8};
+const SDL_Rect letter_g = {60, 61, 8, 8};
+const SDL_Rect letter_h = {68, 61, 8, 8};
+const SDL_Rect letter_i = {76, 61, 8, 8};
+const SDL_Rect letter_j = {84, 61, 8, 8};
+const SDL_Rect letter_k = {92, 61, 8, 8};
+const SDL_Rect letter_l = {100, 61, 8, 8};
+const SDL_Rect letter_m = {108, 61, 8, 8};
+const SDL_Rect letter_n = {116, 61, 8, 8};
+const SDL_Rect letter_o = {124, 61, 8, 8};
+const SDL_Rect letter_p = {4, 69, 8, 8};
+const SDL_Rect letter_q = {12, 69, 8, 8};
+const SDL_Rect letter_r = {20, 69, 8, 8};
+const SDL_Rect letter_s = {28, 69, 8, 8};
+const SDL_Rect letter_t = {36, 69, 8, 8};
+const SDL_Rect letter_u = {44, 69, 8, 8};
+const SDL_Rect letter_v = {52, 69, 8, 8};
+const SDL_Rect letter_w = {60, 69, 8, 8};
+const SDL_Rect letter_x = {68, 69, 8, 8};
+const SDL_Rect letter_y = {76, 69, 8, 8};
+const SDL_Rect letter_z = {84, 69, 8, 8};
+const SDL_Rect letter_point = {92, 69, 8, 8};
+const SDL_Rect letter_0 = {4, 53, 8, 8};
+const SDL_Rect letter_1 = {12, 53, 8, 8};
+const SDL_Rect letter_2 = {20, 53, 8, 8};
+const SDL_Rect letter_3 = {28, 53, 8, 8};
+const SDL_Rect letter_4 = {36, 53, 8, 8};
+const SDL_Rect letter_5 = {44, 53, 8, 8};
+const SDL_Rect letter_6 = {52, 53, 8, 8};
+const SDL_Rect letter_7 = {60, 53, 8, 8};
+const SDL_Rect letter_8 = {68, 53, 8, 8};
+const SDL_Rect letter_9 = {76, 53, 8, 8};
+const SDL_Rect letter_blank = {108, 69, 8, 8};
 
 // Dictionary for letters
-std::map<char, SDL_Rect> sdlChar = {
+const std::map<char, SDL_Rect> sdlChar = {
     {'a', letter_a}, {'b', letter_b}, {'c', letter_c},     {'d', letter_d},
     {'e', letter_e}, {'f', letter_f}, {'g', letter_g},     {'h', letter_h},
     {'i', letter_i}, {'j', letter_j}, {'k', letter_k},     {'l', letter_l},
@@ -183,50 +162,128 @@ std::map<char, SDL_Rect> sdlChar = {
     {'5', letter_5}, {'6', letter_6}, {'7', letter_7},     {'8', letter_8},
     {'9', letter_9}, {'0', letter_0}};
 
-void init(SDL_Window **Window, SDL_Surface **windowSurf,
-          SDL_Surface **spriteBoard) {
+const SDL_Rect *getScoreSprite(int score) {
+    auto it = scoreSprite.find(score);
+    return it == scoreSprite.end() ? nullptr : &it->second;
+}
+
+// Table of the sprites of the 256 characters
+std::vector<SDL_Rect> initGlyphTable() {
+    std::vector<SDL_Rect> glyphTable(256, letter_blank);
+    for (auto &letter : sdlChar)
+        glyphTable[(unsigned char)letter.first] = letter.second;
+    return glyphTable;
+}
+
+const std::vector<SDL_Rect> glyphTable = initGlyphTable();
+
+const SDL_Rect *getCharSprite(char c) { return &glyphTable[(unsigned char)c]; }
+
+void listSprites(DrawList &list) {
+    list.clear();
+    auto add = [&list](const SDL_Rect &src, int w, int h, bool colorKey) {
+        list.commands.push_back({src, {0, 0, w, h}, colorKey, -1});
+    };
+
+    // screens
+    add(src_bg, bg.w, bg.h, false);
+    add(pacmanLogo, 364, 98, false);
+    for (auto &letter : sdlChar)
+        add(letter.second, GLYPH_SIZE, GLYPH_SIZE, false);
+    for (auto &score : scoreSprite)
+        add(score.second, 34, 20, false);
+
+    // items and bottom of the window
+    add(_life, 20, 20, false);
+    add(dot_in, 10, 10, false);
+    add(powerup_in, 20, 20, false);
+    for (auto &fruit : vecFruitSprite) {
+        add(fruit, 20, 20, false);
+        add(fruit, SCALE_PIXEL, SCALE_PIXEL, false);
+    }
+
+    // actors, the ghosts have two frames of wave animation
+    for (auto &ghost : vecGhostSprite) {
+        for (auto sprite : ghost) {
+            add(sprite, SCALE_PIXEL, SCALE_PIXEL, true);
+            sprite.x += 17;
+            add(sprite, SCALE_PIXEL, SCALE_PIXEL, true);
+        }
+    }
+    for (auto sprite : {fearBlueGhostSprite, fearWhiteGhostSprite}) {
+        add(sprite, SCALE_PIXEL, SCALE_PIXEL, true);
+        sprite.x += 17;
+        add(sprite, SCALE_PIXEL, SCALE_PIXEL, true);
+    }
+    for (auto &sprite : {eatenGhostSprite_r, eatenGhostSprite_l,
+                         eatenGhostSprite_u, eatenGhostSprite_d})
+        add(sprite, SCALE_PIXEL, SCALE_PIXEL, true);
+    for (auto &sprite : {pac_blank, pac_r, pac_l, pac_d, pac_u})
+        add(sprite, SCALE_PIXEL, SCALE_PIXEL, true);
+    for (auto &sprite : eatenPacman)
+        add(sprite, SCALE_PIXEL, SCALE_PIXEL, true);
+}
+
+void init(SDL_Window **Window, SDL_Surface **spriteBoard) {
 
     *Window = SDL_CreateWindow("PacMan", SDL_WINDOWPOS_UNDEFINED,
                                SDL_WINDOWPOS_UNDEFINED, 676, 900 + SCORE_HEADER,
                                SDL_WINDOW_SHOWN);
-    *windowSurf = SDL_GetWindowSurface(*Window);
     *spriteBoard = SDL_LoadBMP("assets/pacman_sprites.bmp");
 }
 
-void intro(SDL_Surface **windowSurf, SDL_Surface **spriteBoard, int highScore) {
-    SDL_SetColorKey(*spriteBoard, false, 0);
+/**
+ * @brief Add a sprite of the sprite sheet scaled in an area of the window.
+ *
+ * @param list
+ * @param src the area of the sprite sheet
+ * @param dst the area of the window
+ * @param colorKey the black pixels of the sprite are transparent
+ */
+static void addSprite(DrawList &list, const SDL_Rect &src, const SDL_Rect &dst,
+                      bool colorKey = false) {
+    list.commands.push_back({src, dst, colorKey, -1});
+}
+
+/**
+ * @brief Add an area of the window filled with black.
+ *
+ * @param list
+ * @param dst
+ */
+static void addFill(DrawList &list, const SDL_Rect &dst) {
+    list.commands.push_back({{0, 0, 0, 0}, dst, false, -1});
+}
+
+void buildIntro(DrawList &list, int highScore) {
+    list.clear();
 
     // Area for window
-    SDL_Rect windowArea = {0, 0, 676, 900 + SCORE_HEADER};
-    SDL_FillRect(*windowSurf, &windowArea, 0);
+    addFill(list, {0, 0, 676, 900 + SCORE_HEADER});
 
     // Area for pacman logo
-    SDL_Rect logoArea = {154, 80, 364, 98};
-    SDL_FillRect(*windowSurf, &logoArea, 0);
-    SDL_BlitScaled(*spriteBoard, &pacmanLogo, *windowSurf, &logoArea);
+    addSprite(list, pacmanLogo, {154, 80, 364, 98});
 
     // Print text
-    drawString(windowSurf, spriteBoard, 178, 600, "press enter to start");
+    addString(list, 178, 600, "press enter to start");
 
     // Print high score
     std::string highScoreStr = "high score " + std::to_string(highScore);
-    drawString(windowSurf, spriteBoard, 178, 700, highScoreStr);
+    addString(list, 178, 700, highScoreStr);
 
     // print credits
-    drawString(windowSurf, spriteBoard, 38, 878 + SCORE_HEADER,
-               "coded by ethan huret and thomas dumond");
+    addString(list, 38, 878 + SCORE_HEADER,
+              "coded by ethan huret and thomas dumond");
 }
 
-void gameOver(SDL_Surface **windowSurf, SDL_Surface **spriteBoard, int curScore,
-              int highScore) {
-    SDL_SetColorKey(*spriteBoard, false, 0);
+void buildGameOver(DrawList &list, int curScore, int highScore) {
+    list.clear();
 
     // Area for window
-    SDL_Rect windowArea = {0, 0, 676, 900 + SCORE_HEADER};
-    SDL_FillRect(*windowSurf, &windowArea, 0);
+    addFill(list, {0, 0, 676, 900 + SCORE_HEADER});
 
     // Print text
-    drawString(windowSurf, spriteBoard, 250, 450, "game over !");
+    addString(list, 250, 450, "game over !");
 
     if (curScore > highScore) {
         highScore = curScore;
@@ -234,146 +291,134 @@ void gameOver(SDL_Surface **windowSurf, SDL_Surface **spriteBoard, int curScore,
 
     // Print score
     std::string scoreStr = "your score " + std::to_string(curScore);
-    drawString(windowSurf, spriteBoard, 178, 600, scoreStr);
+    addString(list, 178, 600, scoreStr);
 
     // Print high score
     std::string highScoreStr = "high score " + std::to_string(highScore);
-    drawString(windowSurf, spriteBoard, 178, 700, highScoreStr);
+    addString(list, 178, 700, highScoreStr);
 }
 
-int draw(SDL_Surface **windowSurf, SDL_Surface **spriteBoard, int count,
-         pacman Pacman, std::vector<std::shared_ptr<ghost>> vecGhost,
-         std::vector<Coordinate> vecDot, std::vector<Coordinate> vecPowerup,
-         typeFruit fruit, int curScore, int highScore, short death, bool start,
-         int curLevel) {
-    SDL_SetColorKey(*spriteBoard, false, 0);
-    SDL_BlitScaled(*spriteBoard, &src_bg, *windowSurf, &bg);
+// Strings of the header of the last frame
+struct HeaderStrings {
+    int score = -1;
+    int highScore = -1;
+    int level = -1;
+    std::string scoreString, highScoreString, levelString;
+};
 
-    count = (count + 1) % (512);
+static HeaderStrings header;
 
-    // clear the area for the score header
-    SDL_Rect scoreHeaderArea = {0, 0, 676, SCORE_HEADER};
-    SDL_FillRect(*windowSurf, &scoreHeaderArea, 0);
+int buildFrame(DrawList &list, int count, pacman &Pacman, ghostPack &Ghosts,
+               const std::vector<Coordinate> &vecDot,
+               const std::vector<Coordinate> &vecPowerup, typeFruit fruit,
+               int curScore, int highScore, short death, bool start,
+               int curLevel, const gameClock &Clock) {
+    list.clear();
+    addSprite(list, src_bg, bg);
 
-    // combine the score string and the score number into one string
-    std::string scoreString = "score " + std::to_string(curScore);
+    count = (count + 1) % (512);
 
-    // print the score string
-    drawString(windowSurf, spriteBoard, SCORE_HEADER / 2, SCORE_HEADER / 2,
-               scoreString);
+    // clear the area for the score header
+    addFill(list, {0, 0, 676, SCORE_HEADER});
 
     if (curScore > highScore) {
         highScore = curScore;
     }
 
-    // combine the score string and the score number into one string
-    std::string highScoreString = "high score " + std::to_string(highScore);
-
-    // print the score string
-    drawString(windowSurf, spriteBoard, 400 - SCORE_HEADER / 2 - 144,
-               SCORE_HEADER / 2, highScoreString);
-
-    // combine the level string and the level number into one string
-    std::string levelString = "level " + std::to_string(curLevel);
+    // the strings of the header are only made again when a number changes
+    if (curScore != header.score) {
+        header.score = curScore;
+        header.scoreString = "score " + std::to_string(curScore);
+    }
+    if (highScore != header.highScore) {
+        header.highScore = highScore;
+        header.highScoreString = "high score " + std::to_string(highScore);
+    }
+    if (curLevel != header.level) {
+        header.level = curLevel;
+        header.levelString = "level " + std::to_string(curLevel);
+    }
 
-    // print the level string
-    drawString(windowSurf, spriteBoard, 676 - SCORE_HEADER / 2 - 128,
-               SCORE_HEADER / 2, levelString);
+    // print the score, the high score and the level
+    addString(list, SCORE_HEADER / 2, SCORE_HEADER / 2, header.scoreString);
+    addString(list, 400 - SCORE_HEADER / 2 - 144, SCORE_HEADER / 2,
+              header.highScoreString);
+    addString(list, 676 - SCORE_HEADER / 2 - 128, SCORE_HEADER / 2,
+              header.levelString);
 
-    // area for score
-    SDL_Rect scoreArea = {0, 864 + SCORE_HEADER, 676, 36};
-    SDL_FillRect(*windowSurf, &scoreArea, 0);
+    // area for score, with the remaining life and eaten fruits
+    addFill(list, {0, 864 + SCORE_HEADER, 676, 36});
 
-    // print the remaining life and eaten fruits
-    SDL_Rect lifeArea = {4, 874 + SCORE_HEADER, 676, 20};
-    // Erase the area
-    SDL_FillRect(*windowSurf, &lifeArea, 0);
-    for (auto i = 0; i < Pacman.getRemainingLife(); i++) {
-        SDL_Rect life = {4 + i * 22, 874 + SCORE_HEADER, 20, 20};
-        SDL_BlitScaled(*spriteBoard, &_life, *windowSurf, &life);
-    }
+    // print the remaining life
+    for (auto i = 0; i < Pacman.getRemainingLife(); i++)
+        addSprite(list, _life, {4 + i * 22, 874 + SCORE_HEADER, 20, 20});
 
     // print the eaten fruit
-    for (auto i = 0; i < int(Pacman.getEatenFruit().size()); i++) {
-        SDL_Rect fruit = {400 + i * 32, 874 + SCORE_HEADER, 20, 20};
-        SDL_BlitScaled(*spriteBoard, &vecFruitSprite[i], *windowSurf, &fruit);
-    }
+    for (auto i = 0; i < int(Pacman.getEatenFruit().size()); i++)
+        addSprite(list, vecFruitSprite[i],
+                  {400 + i * 32, 874 + SCORE_HEADER, 20, 20});
 
     // print ready before the game starts
     if (!start)
-        drawString(windowSurf, spriteBoard, 298, 492 + SCORE_HEADER, "ready");
+        addString(list, 298, 492 + SCORE_HEADER, "ready");
 
     // dot display
-    for (auto &coord : vecDot) {
-        SDL_Rect dot = {coord.x * SCALE_PIXEL + 11,
-                        coord.y * SCALE_PIXEL + 15 + SCORE_HEADER, 10, 10};
-        SDL_BlitScaled(*spriteBoard, &dot_in, *windowSurf, &dot);
-    }
+    for (auto &coord : vecDot)
+        addSprite(list, dot_in,
+                  {coord.x * SCALE_PIXEL + 11,
+                   coord.y * SCALE_PIXEL + 15 + SCORE_HEADER, 10, 10});
 
     // powerup display
     if ((count / 8) % 2 == 0) {
-        for (auto &coord : vecPowerup) {
-            SDL_Rect powerup = {coord.x * SCALE_PIXEL + 6,
-                                coord.y * SCALE_PIXEL + 10 + SCORE_HEADER, 20,
-                                20};
-            SDL_BlitScaled(*spriteBoard, &powerup_in, *windowSurf, &powerup);
-        }
+        for (auto &coord : vecPowerup)
+            addSprite(list, powerup_in,
+                      {coord.x * SCALE_PIXEL + 6,
+                       coord.y * SCALE_PIXEL + 10 + SCORE_HEADER, 20, 20});
     }
 
     // fruit display
-    if (fruit != _NONE) {
-        SDL_Rect fruitSdl = {FRUIT_X * SCALE_PIXEL,
-                             FRUIT_Y * SCALE_PIXEL + SCORE_HEADER, SCALE_PIXEL,
-                             SCALE_PIXEL};
-        SDL_BlitScaled(*spriteBoard, &vecFruitSprite[fruit - 1], *windowSurf,
-                       &fruitSdl);
-    }
-
-    // score fruit display
-    if (Pacman.getFruitEatenScore() != 0) {
-
-        time_t fruitEatenTimer2 = std::chrono::steady_clock::now();
-        std::chrono::duration<double> elapsedTime =
-            fruitEatenTimer2 - Pacman.getfruitEatenTimer();
-
-        if (elapsedTime.count() < FRUIT_SCORE_DISPLAY_TIME) {
-
-            // Place the area to write the score
-            SDL_Rect pointArea = {FRUIT_X * SCALE_PIXEL,
-                                  FRUIT_Y * SCALE_PIXEL + 10 + SCORE_HEADER, 34,
-                                  20};
-
-            // print the score
-            SDL_BlitScaled(*spriteBoard,
-                           &scoreSprite[Pacman.getFruitEatenScore()],
-                           *windowSurf, &pointArea);
-        } else
-            Pacman.setFruitEatenScore(0);
+    if (fruit != _NONE)
+        addSprite(list, vecFruitSprite[fruit - 1],
+                  {FRUIT_X * SCALE_PIXEL, FRUIT_Y * SCALE_PIXEL + SCORE_HEADER,
+                   SCALE_PIXEL, SCALE_PIXEL});
+
+    // score fruit display, the frame does not change the game so that the
+    // game is the same with or without display
+    if (Pacman.getFruitEatenScore() != 0 &&
+        Clock.getElapsed(Pacman.getfruitEatenTimer()) <
+            FRUIT_SCORE_DISPLAY_TIME) {
+
+        // print the score
+        const SDL_Rect *score_in = getScoreSprite(Pacman.getFruitEatenScore());
+        if (score_in != nullptr)
+            addSprite(list, *score_in,
+                      {FRUIT_X * SCALE_PIXEL,
+                       FRUIT_Y * SCALE_PIXEL + 10 + SCORE_HEADER, 34, 20});
     }
 
     // do not draw ghost if pacman is dead
     if (death == PACMAN_LIVE) {
 
-        for (auto &Ghost : vecGhost) {
+        for (auto &Ghost : Ghosts) {
             // _ghost look animation
-            SDL_Rect *ghost_in = nullptr;
+            const SDL_Rect *ghost_in = nullptr;
             // normal mode
-            switch (Ghost->getLastDir()) {
+            switch (Ghost.getLastDir()) {
             case LEFT:
-                ghost_in = &(vecGhostSprite[Ghost->getGhost()][LEFT]);
+                ghost_in = &(vecGhostSprite[Ghost.getGhost()][LEFT]);
                 break;
             case RIGHT:
-                ghost_in = &(vecGhostSprite[Ghost->getGhost()][RIGHT]);
+                ghost_in = &(vecGhostSprite[Ghost.getGhost()][RIGHT]);
                 break;
             case UP:
-                ghost_in = &(vecGhostSprite[Ghost->getGhost()][UP]);
+                ghost_in = &(vecGhostSprite[Ghost.getGhost()][UP]);
                 break;
             case DOWN:
-                ghost_in = &(vecGhostSprite[Ghost->getGhost()][DOWN]);
+                ghost_in = &(vecGhostSprite[Ghost.getGhost()][DOWN]);
                 break;
             case NONE:
                 // by default, _ghost looks right
-                ghost_in = &(vecGhostSprite[Ghost->getGhost()][RIGHT]);
+                ghost_in = &(vecGhostSprite[Ghost.getGhost()][RIGHT]);
                 break;
             }
 
@@ -383,14 +428,11 @@ int draw(SDL_Surface **windowSurf, SDL_Surface **spriteBoard, int count,
                 ghost_in2.x += 17;
 
             // fear mode
-            if (Ghost->isFrightened() == true && Ghost->isInHouse() == false &&
-                Ghost->isReturnHouse() == false) {
-
-                time_t powerupTimer2 = std::chrono::steady_clock::now();
-                std::chrono::duration<double> elapsedTime =
-                    powerupTimer2 - Pacman.getPowerupTimer();
+            if (Ghost.isFrightened() == true && Ghost.isInHouse() == false &&
+                Ghost.isReturnHouse() == false) {
 
-                if (elapsedTime.count() < POWERUP_MODE - GHOST_BLINK)
+                if (Clock.getElapsed(Pacman.getPowerupTimer()) <
+                    POWERUP_MODE - GHOST_BLINK)
                     ghost_in = &(fearBlueGhostSprite);
                 else {
                     if ((count / 8) % 2)
@@ -406,24 +448,24 @@ int draw(SDL_Surface **windowSurf, SDL_Surface **spriteBoard, int count,
             }
 
             // go back to house mode
-            else if (Ghost->isReturnHouse() == true) {
+            else if (Ghost.isReturnHouse() == true) {
 
                 // place the area to write the score
                 SDL_Rect pointArea = {0, 0, 34, 20};
 
                 // new ghost is eaten
                 pointArea.x =
-                    int(Ghost->getEatenPosition().first) + (GHOST_CENTER_X / 2);
-                pointArea.y = int(Ghost->getEatenPosition().second +
+                    int(Ghost.getEatenPosition().first) + (GHOST_CENTER_X / 2);
+                pointArea.y = int(Ghost.getEatenPosition().second +
                                   (GHOST_CENTER_Y / 2) + SCORE_HEADER);
 
-                if (Pacman.getGhostEatenColor() == Ghost->getGhost())
-
-                    SDL_BlitScaled(*spriteBoard,
-                                   &scoreSprite[Pacman.getGhostEatenScore()],
-                                   *windowSurf, &pointArea);
+                const SDL_Rect *score_in =
+                    getScoreSprite(Pacman.getGhostEatenScore());
+                if (Pacman.getGhostEatenColor() == Ghost.getGhost() &&
+                    score_in != nullptr)
+                    addSprite(list, *score_in, pointArea);
 
-                switch (Ghost->getLastDir()) {
+                switch (Ghost.getLastDir()) {
                 case RIGHT:
                     ghost_in2 = eatenGhostSprite_r;
                     break;
@@ -443,13 +485,11 @@ int draw(SDL_Surface **windowSurf, SDL_Surface **spriteBoard, int count,
             }
 
             // ghost updated position
-            vecGhostSprite[Ghost->getGhost()].back().x = Ghost->getPos().first;
-            vecGhostSprite[Ghost->getGhost()].back().y =
-                Ghost->getPos().second + SCORE_HEADER;
-
-            SDL_SetColorKey(*spriteBoard, true, 0);
-            SDL_BlitScaled(*spriteBoard, &ghost_in2, *windowSurf,
-                           &vecGhostSprite[Ghost->getGhost()].back());
+            addSprite(list, ghost_in2,
+                      {int(Ghost.getPos().first),
+                       int(Ghost.getPos().second + SCORE_HEADER), SCALE_PIXEL,
+                       SCALE_PIXEL},
+                      true);
         }
     }
 
@@ -499,30 +539,19 @@ int draw(SDL_Surface **windowSurf, SDL_Surface **spriteBoard, int count,
     }
 
     // pacman updated position
-    _pacman.x = Pacman.getPos().first;
-    _pacman.y = Pacman.getPos().second + SCORE_HEADER;
-
-    SDL_SetColorKey(*spriteBoard, true, 0);
-    SDL_BlitScaled(*spriteBoard, &pac_in, *windowSurf, &_pacman);
+    addSprite(list, pac_in,
+              {int(Pacman.getPos().first),
+               int(Pacman.getPos().second + SCORE_HEADER), SCALE_PIXEL,
+               SCALE_PIXEL},
+              true);
 
     return count;
 }
 
-void drawString(SDL_Surface **windowSurf, SDL_Surface **spriteBoard, int x,
-                int y, std::string str) {
-    // Get the string length
-    int len = str.length();
-
-    // Create a rectangle for the text
-    SDL_Rect area = {x, y, 16 * (len + 2), 16};
-
-    // Erase the area
-    SDL_FillRect(*windowSurf, &area, 0);
-
-    // Print the text
-    SDL_Rect textRect = {x, y, 16, 16};
-    for (auto s : str) {
-        SDL_BlitScaled(*spriteBoard, &sdlChar[s], *windowSurf, &textRect);
-        textRect.x += 16;
-    }
-}
\ No newline at end of file
+void addString(DrawList &list, int x, int y, const std::string &str) {
+    // the text is drawn on a black area two characters longer
+    SDL_Rect area = {x, y, GLYPH_SIZE * (int(str.length()) + 2), GLYPH_SIZE};
+    int text = int(list.texts.size());
+    list.commands.push_back({{0, 0, 0, 0}, area, false, text});
+    list.texts.push_back(str);
+}
@@ -0,0 +1,46 @@
+#include "grid.h"
+
+std::atomic<size_t> grid::_copyCount(0);
+
+grid::grid() {
+    _width = 0;
+    _height = 0;
+}
+
+grid::grid(size_t width, size_t height) { resize(width, height); }
+
+grid::grid(gridView view) {
+    DEB(_copyCount++);
+    resize(view.getWidth(), view.getHeight());
+    for (size_t y = 0; y < _height; y++) {
+        for (size_t x = 0; x < _width; x++)
+            at(x, y) = view.at(x, y);
+    }
+}
+
+grid::grid(const grid &other)
+    : _width(other._width), _height(other._height), _squares(other._squares) {
+    DEB(_copyCount++);
+}
+
+grid &grid::operator=(const grid &other) {
+    DEB(_copyCount++);
+    _width = other._width;
+    _height = other._height;
+    _squares = other._squares;
+    return *this;
+}
+
+grid::~grid() {}
+
+void grid::resize(size_t width, size_t height) {
+    _width = width;
+    _height = height;
+    _squares.assign(width * height, square());
+}
+
+gridView grid::getView(const pathTable *paths, pelletTracker *pellets) {
+    return gridView(_squares.data(), _width, _height, _width, paths, pellets);
+}
+
+size_t grid::getCopyCount() { return _copyCount; }
@@ -0,0 +1,302 @@
+#include "level.h"
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// items and moves of the classic maze
+static const Coordinate classicPowerups[] = {
+    {1, 3}, {19, 3}, {1, 20}, {19, 20}};
+// middle of the map, around the ghost house
+static const Zone classicEmptyZones[] = {{6, 9, 14, 17}};
+// above and below the ghost house
+static const Zone classicStraightZones[] = {{8, 10, 12, 10}, {8, 20, 12, 20}};
+
+level::level() {
+    _width = 0;
+    _height = 0;
+    _tunnelDepth = 0;
+    memset(&_header, 0, sizeof(_header));
+    _states = nullptr;
+    _map = nullptr;
+    _mapSize = 0;
+}
+
+level::~level() { unmap(); }
+
+void level::unmap() {
+    if (_map != nullptr)
+        munmap(_map, _mapSize);
+    _map = nullptr;
+    _mapSize = 0;
+}
+
+bool level::load(const std::string &fileName) {
+
+    std::ifstream file(fileName, std::ios::binary);
+    if (!file.is_open())
+        return false;
+    uint32_t magic = 0;
+    file.read(reinterpret_cast<char *>(&magic), sizeof(magic));
+    file.close();
+
+    unmap();
+    _states = nullptr;
+    _ownStates.clear();
+
+    bool loaded = magic == LEVEL_MAGIC ? loadCompiled(fileName)
+                                       : loadText(fileName);
+    if (!loaded || !index()) {
+        unmap();
+        _width = 0;
+        _height = 0;
+        _states = nullptr;
+        return false;
+    }
+    return true;
+}
+
+bool level::loadText(const std::string &fileName) {
+
+    std::ifstream inputFile(fileName);
+    if (!inputFile.is_open())
+        return false;
+
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(inputFile, line)) {
+        if (!line.empty())
+            lines.push_back(line);
+    }
+    if (lines.empty())
+        return false;
+
+    // each line of the file is a line of the maze
+    _width = lines[0].size();
+    _height = lines.size();
+    _ownStates.resize(_width * _height);
+    for (size_t y = 0; y < _height; y++) {
+        if (lines[y].size() != _width)
+            return false;
+        for (size_t x = 0; x < _width; x++)
+            _ownStates[y * _width + x] = uint8_t(lines[y][x] - '0');
+    }
+    _states = _ownStates.data();
+
+    _tunnelDepth = TUNNEL_DEPTH;
+    _header.pacman = {PACMAN_INIT_X, PACMAN_INIT_Y};
+    _header.ghostExit = {GHOST_INIT_X, GHOST_INIT_Y};
+    _header.fruit = {FRUIT_X, FRUIT_Y};
+    _header.home[RED] = {RED_GHOST_INIT_X, RED_GHOST_INIT_Y};
+    _header.home[PINK] = {PINK_GHOST_INIT_X, PINK_GHOST_INIT_Y};
+    _header.home[BLUE] = {BLUE_GHOST_INIT_X, BLUE_GHOST_INIT_Y};
+    _header.home[ORANGE] = {ORANGE_GHOST_INIT_X, ORANGE_GHOST_INIT_Y};
+    _header.scatter[RED] = {RED_GHOST_SCATTER_X, RED_GHOST_SCATTER_Y};
+    _header.scatter[PINK] = {PINK_GHOST_SCATTER_X, PINK_GHOST_SCATTER_Y};
+    _header.scatter[BLUE] = {BLUE_GHOST_SCATTER_X, BLUE_GHOST_SCATTER_Y};
+    _header.scatter[ORANGE] = {ORANGE_GHOST_SCATTER_X,
+                               ORANGE_GHOST_SCATTER_Y};
+    _powerups.assign(std::begin(classicPowerups), std::end(classicPowerups));
+    _emptyZones.assign(std::begin(classicEmptyZones),
+                       std::end(classicEmptyZones));
+    _straightZones.assign(std::begin(classicStraightZones),
+                          std::end(classicStraightZones));
+    return true;
+}
+
+bool level::loadCompiled(const std::string &fileName) {
+
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd == -1)
+        return false;
+    struct stat info;
+    if (fstat(fd, &info) == -1 || size_t(info.st_size) < sizeof(LevelHeader)) {
+        close(fd);
+        return false;
+    }
+    _mapSize = info.st_size;
+    _map = mmap(nullptr, _mapSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (_map == MAP_FAILED) {
+        _map = nullptr;
+        return false;
+    }
+
+    // the counts are added in 64 bits so that a corrupt file can not wrap
+    // around the size of the mapping
+    const char *data = static_cast<const char *>(_map);
+    memcpy(&_header, data, sizeof(_header));
+    uint64_t size = sizeof(LevelHeader) +
+                    uint64_t(_header.nbPowerups) * sizeof(Coordinate) +
+                    (uint64_t(_header.nbEmptyZones) +
+                     _header.nbStraightZones) *
+                        sizeof(Zone) +
+                    uint64_t(_header.width) * _header.height;
+    if (_header.version != LEVEL_VERSION || _header.width == 0 ||
+        _header.height == 0 || _mapSize < size)
+        return false;
+
+    _width = _header.width;
+    _height = _header.height;
+    _tunnelDepth = _header.tunnelDepth;
+
+    // the lists are small, the states are read in the mapped file
+    const Coordinate *powerups =
+        reinterpret_cast<const Coordinate *>(data + sizeof(LevelHeader));
+    _powerups.assign(powerups, powerups + _header.nbPowerups);
+    const Zone *zones =
+        reinterpret_cast<const Zone *>(powerups + _header.nbPowerups);
+    _emptyZones.assign(zones, zones + _header.nbEmptyZones);
+    zones += _header.nbEmptyZones;
+    _straightZones.assign(zones, zones + _header.nbStraightZones);
+    zones += _header.nbStraightZones;
+    _states = reinterpret_cast<const uint8_t *>(zones);
+    for (size_t i = 0; i < _width * _height; i++) {
+        if (_states[i] != HALL && _states[i] != WALL && _states[i] != DOOR)
+            return false;
+    }
+    return true;
+}
+
+bool level::index() {
+
+    auto isInside = [this](Coordinate coord) {
+        return coord.x >= 0 && coord.y >= 0 && size_t(coord.x) < _width &&
+               size_t(coord.y) < _height;
+    };
+    // the house is below the exit
+    Coordinate house = {_header.ghostExit.x, _header.ghostExit.y + 3};
+    bool inside = isInside(_header.pacman) && isInside(_header.ghostExit) &&
+                  isInside(house) && isInside(_header.fruit);
+    for (int c = 0; c < NB_COLORS; c++)
+        inside = inside && isInside(_header.home[c]) &&
+                 isInside(_header.scatter[c]);
+    for (auto &coord : _powerups)
+        inside = inside && isInside(coord);
+    if (!inside)
+        return false;
+
+    _tunnel.assign(_height, 0);
+    for (size_t y = 0; y < _height; y++)
+        _tunnel[y] = getState(0, y) != WALL && getState(_width - 1, y) != WALL;
+
+    _flags.assign(_width * _height, 0);
+    auto setFlag = [this](const std::vector<Zone> &zones, uint8_t flag) {
+        for (auto &zone : zones) {
+            for (int y = std::max(zone.yMin, 0);
+                 y <= zone.yMax && size_t(y) < _height; y++) {
+                for (int x = std::max(zone.xMin, 0);
+                     x <= zone.xMax && size_t(x) < _width; x++)
+                    _flags[y * _width + x] |= flag;
+            }
+        }
+    };
+    setFlag(_emptyZones, FLAG_EMPTY);
+    setFlag(_straightZones, FLAG_STRAIGHT);
+
+    // no dot at the ends of the tunnels and on the spawn of pacman
+    for (size_t y = 0; y < _height; y++) {
+        for (size_t x = 0; x < _width; x++) {
+            if (isTunnelEnd(x, y))
+                _flags[y * _width + x] |= FLAG_EMPTY;
+        }
+    }
+    _flags[_header.pacman.y * _width + _header.pacman.x] |= FLAG_EMPTY;
+    return true;
+}
+
+bool level::save(const std::string &fileName) const {
+
+    std::ofstream file(fileName, std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    LevelHeader header = _header;
+    header.magic = LEVEL_MAGIC;
+    header.version = LEVEL_VERSION;
+    header.width = _width;
+    header.height = _height;
+    header.tunnelDepth = _tunnelDepth;
+    header.nbPowerups = _powerups.size();
+    header.nbEmptyZones = _emptyZones.size();
+    header.nbStraightZones = _straightZones.size();
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(_powerups.data()),
+               _powerups.size() * sizeof(Coordinate));
+    file.write(reinterpret_cast<const char *>(_emptyZones.data()),
+               _emptyZones.size() * sizeof(Zone));
+    file.write(reinterpret_cast<const char *>(_straightZones.data()),
+               _straightZones.size() * sizeof(Zone));
+    file.write(reinterpret_cast<const char *>(_states), _width * _height);
+
+    return bool(file);
+}
+
+uint64_t level::getHash() const {
+
+    // FNV-1a of the dimensions, the positions and the states
+    uint64_t hash = 0xcbf29ce484222325;
+    auto add = [&hash](const void *data, size_t size) {
+        const uint8_t *bytes = static_cast<const uint8_t *>(data);
+        for (size_t i = 0; i < size; i++)
+            hash = (hash ^ bytes[i]) * 0x100000001b3;
+    };
+    uint64_t dimensions[3] = {_width, _height, _tunnelDepth};
+    add(dimensions, sizeof(dimensions));
+    add(&_header.pacman, sizeof(Coordinate));
+    add(&_header.ghostExit, sizeof(Coordinate));
+    add(&_header.fruit, sizeof(Coordinate));
+    add(_header.home, sizeof(_header.home));
+    add(_header.scatter, sizeof(_header.scatter));
+    add(_powerups.data(), _powerups.size() * sizeof(Coordinate));
+    add(_emptyZones.data(), _emptyZones.size() * sizeof(Zone));
+    add(_straightZones.data(), _straightZones.size() * sizeof(Zone));
+    if (_states != nullptr)
+        add(_states, _width * _height);
+    return hash;
+}
+
+void level::tile(size_t nbTiles) {
+
+    if (nbTiles <= 1 || _states == nullptr)
+        return;
+
+    size_t width = _width * nbTiles;
+    std::vector<uint8_t> states(width * _height);
+    for (size_t y = 0; y < _height; y++) {
+        for (size_t x = 0; x < width; x++)
+            states[y * width + x] = getState(x % _width, y);
+    }
+
+    // the items and the zones are repeated in each copy
+    std::vector<Coordinate> powerups;
+    std::vector<Zone> emptyZones, straightZones;
+    for (size_t i = 0; i < nbTiles; i++) {
+        int dx = int(i * _width);
+        for (auto &coord : _powerups)
+            powerups.push_back({coord.x + dx, coord.y});
+        for (auto &zone : _emptyZones)
+            emptyZones.push_back(
+                {zone.xMin + dx, zone.yMin, zone.xMax + dx, zone.yMax});
+        for (auto &zone : _straightZones)
+            straightZones.push_back(
+                {zone.xMin + dx, zone.yMin, zone.xMax + dx, zone.yMax});
+    }
+
+    // the corners on the right go to the last copy
+    int dx = int((nbTiles - 1) * _width);
+    for (int c = 0; c < NB_COLORS; c++) {
+        if (size_t(_header.scatter[c].x) >= _width / 2)
+            _header.scatter[c].x += dx;
+    }
+
+    unmap();
+    _ownStates.swap(states);
+    _states = _ownStates.data();
+    _width = width;
+    _powerups.swap(powerups);
+    _emptyZones.swap(emptyZones);
+    _straightZones.swap(straightZones);
+    index();
+}
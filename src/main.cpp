@@ -1,22 +1,468 @@
-#include "graphic.h"
-
-void quit(std::vector<Coordinate> vecDot, std::vector<Coordinate> vecPowerup,
-          std::vector<std::shared_ptr<ghost>> vecGhost, pacman Pacman,
-          board Board, SDL_Surface *spriteBoard, SDL_Surface *windowSurf) {
-
-    vecDot.clear();
-    vecPowerup.clear();
-    for (auto Ghost : vecGhost)
-        Ghost->~ghost();
-    vecGhost.clear();
-    Pacman.~pacman();
-    Board.~board();
+#include "display.h"
+#include "framebuffer.h"
+#include "mcts.h"
+#include "replay.h"
+#include <chrono>
+#include <thread>
+#include <cstring>
+
+#define SPEED_MAX 0   // no wait between the ticks
+#define RENDER_NONE 0 // never draw the game
+// frames drawn at full speed, one per second of game
+#define SPEED_MAX_RENDER TICKS_PER_SECOND
+
+struct Options {
+    uint64_t seed;
+    // number of ticks per frame of 10ms, SPEED_MAX to not wait
+    int speed;
+    // one frame out of render is drawn, RENDER_NONE to draw nothing
+    int render;
+    // how the frames are drawn in the window
+    backend Backend;
+    // the simulation runs on its own thread
+    bool pipeline;
+    // file where the game is recorded, nullptr to not record it
+    const char *record;
+    // replay played without display, nullptr to play the game
+    const char *replay;
+    // pacman is played by the mcts autopilot, the games follow each other
+    // without waiting for the player
+    bool autopilot;
+    MctsOptions mcts;
+};
+
+// game being recorded, saved at game over and when the game is left
+struct Recording {
+    replay Replay;
+    const char *fileName;
+    simulation *Sim;
+};
+static Recording recording = {replay(), nullptr, nullptr};
+
+/**
+ * @brief Read a strictly positive integer in an option.
+ *
+ * @param option the name of the option
+ * @param value the text of the value
+ * @return int
+ */
+int readPositive(const char *option, const char *value) {
+
+    char *end = nullptr;
+    long number = strtol(value, &end, 10);
+    if (end == value || *end != '\0' || number <= 0 || number > INT32_MAX) {
+        std::cerr << "Invalid " << option << ": " << value << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    return int(number);
+}
+
+/**
+ * @brief Read the options given on the command line.
+ *
+ * @param argc
+ * @param argv
+ * @return Options
+ */
+Options readOptions(int argc, char **argv) {
+
+    Options options = {DEFAULT_SEED, 1, -1, BACKEND_SURFACE, false, nullptr,
+                       nullptr, false,
+                       {std::thread::hardware_concurrency(),
+                        MCTS_DEFAULT_TIME, 0}};
+
+    for (int i = 1; i < argc; i++) {
+        // seed of the random decisions of the ghosts
+        if (strncmp(argv[i], "--seed=", 7) == 0) {
+            char *end = nullptr;
+            options.seed = strtoull(argv[i] + 7, &end, 0);
+            if (end == argv[i] + 7 || *end != '\0') {
+                std::cerr << "Invalid seed: " << argv[i] + 7 << std::endl;
+                exit(EXIT_FAILURE);
+            }
+        }
+        // number of ticks played per frame
+        else if (strncmp(argv[i], "--speed=", 8) == 0) {
+            if (strcmp(argv[i] + 8, "max") == 0)
+                options.speed = SPEED_MAX;
+            else
+                options.speed = readPositive("speed", argv[i] + 8);
+        }
+        // one frame drawn out of N
+        else if (strncmp(argv[i], "--render=", 9) == 0) {
+            if (strcmp(argv[i] + 9, "none") == 0)
+                options.render = RENDER_NONE;
+            else
+                options.render = readPositive("render", argv[i] + 9);
+        }
+        // backend of the display
+        else if (strncmp(argv[i], "--renderer=", 11) == 0) {
+            if (strcmp(argv[i] + 11, "surface") == 0)
+                options.Backend = BACKEND_SURFACE;
+            else if (strcmp(argv[i] + 11, "texture") == 0)
+                options.Backend = BACKEND_TEXTURE;
+            else if (strcmp(argv[i] + 11, "software") == 0)
+                options.Backend = BACKEND_SOFTWARE;
+            else {
+                std::cerr << "Invalid renderer: " << argv[i] + 11 << std::endl;
+                exit(EXIT_FAILURE);
+            }
+        }
+        // simulation and display on two threads
+        else if (strcmp(argv[i], "--pipeline") == 0)
+            options.pipeline = true;
+        // record the input of the games
+        else if (strncmp(argv[i], "--record=", 9) == 0)
+            options.record = argv[i] + 9;
+        // play a recorded game again without display
+        else if (strncmp(argv[i], "--replay=", 9) == 0)
+            options.replay = argv[i] + 9;
+        // pacman played by the computer
+        else if (strcmp(argv[i], "--autopilot=mcts") == 0)
+            options.autopilot = true;
+        // time of the search of each direction of the autopilot
+        else if (strncmp(argv[i], "--mcts-time=", 12) == 0)
+            options.mcts.time = readPositive("mcts-time", argv[i] + 12);
+        // threads of the search of the autopilot
+        else if (strncmp(argv[i], "--mcts-threads=", 15) == 0)
+            options.mcts.threads = readPositive("mcts-threads", argv[i] + 15);
+        else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--seed=N] [--speed=N|max] [--render=N|none]"
+                         " [--renderer=surface|texture|software] [--pipeline]"
+                         " [--record=FILE] [--replay=FILE] [--autopilot=mcts]"
+                         " [--mcts-time=MS] [--mcts-threads=N]"
+                      << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    // every frame is drawn by default, except at full speed
+    if (options.render == -1)
+        options.render = options.speed == SPEED_MAX ? SPEED_MAX_RENDER : 1;
+
+    return options;
+}
+
+/**
+ * @brief Save the game being recorded, if any.
+ */
+void saveRecording() {
+
+    if (recording.fileName == nullptr || !recording.Replay.isStarted())
+        return;
+    recording.Replay.finish(*recording.Sim);
+    if (!recording.Replay.save(recording.fileName))
+        std::cerr << "Unable to save the replay in " << recording.fileName
+                  << std::endl;
+}
+
+/**
+ * @brief Play a replay as fast as possible, without display, and compare the
+ * end of the game with the recorded one.
+ *
+ * @param fileName
+ * @return int EXIT_SUCCESS if the game ends as it was recorded
+ */
+int playReplay(const char *fileName) {
+
+    replay Replay;
+    if (!Replay.load(fileName)) {
+        std::cerr << "Unable to read the replay " << fileName << std::endl;
+        return EXIT_FAILURE;
+    }
+    const ReplayHeader &header = Replay.getHeader();
+
+    simulation Sim(header.seed);
+    Sim.load(Replay.getLevelName());
+    if (Sim.getBoard().getLevel().getHash() != header.levelHash)
+        std::cerr << "Warning: " << Replay.getLevelName()
+                  << " changed since the recording" << std::endl;
+    if (Replay.getBuild() != replay::currentBuild())
+        std::cerr << "Warning: recorded by build " << Replay.getBuild()
+                  << ", played by build " << replay::currentBuild()
+                  << std::endl;
+
+    auto start = std::chrono::steady_clock::now();
+    ReplayResult result = Replay.play(Sim);
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    std::cout << "replay   " << fileName << " (seed " << header.seed << ", "
+              << header.nbGhosts << " ghosts, " << header.nbChanges
+              << " changes of direction)" << std::endl;
+    std::cout << "score    " << result.score << " (recorded " << header.score
+              << ")" << std::endl;
+    std::cout << "level    " << result.level << " (recorded " << header.level
+              << ")" << std::endl;
+    std::cout << "deaths   " << result.deaths << std::endl;
+    std::cout << "ticks    " << result.ticks << " in " << elapsed.count()
+              << "s" << std::endl;
+    if (result.divergence != REPLAY_NO_DIVERGENCE)
+        std::cout << "diverged before the step " << result.divergence
+                  << std::endl;
+
+    if (result.score != header.score ||
+        uint32_t(result.level) != header.level ||
+        result.divergence != REPLAY_NO_DIVERGENCE) {
+        std::cerr << "The replay does not end as the recorded game"
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+void quit(SDL_Surface *spriteBoard, display &Display) {
+
+    saveRecording();
+    Display.close();
     SDL_FreeSurface(spriteBoard);
-    SDL_FreeSurface(windowSurf);
     SDL_Quit();
 }
 
-int main() {
+/**
+ * @brief Read the events during a life: leave the game when the window is
+ * closed or escape is pressed, draw the window again when it is shown.
+ *
+ * @param event the last event, kept while no other event comes
+ * @param spriteBoard
+ * @param Display
+ */
+void pollLife(SDL_Event &event, SDL_Surface *spriteBoard, display &Display) {
+
+    // event management
+    if (SDL_PollEvent(&event)) {
+        switch (event.type) {
+        // leave the game
+        case SDL_QUIT:
+            quit(spriteBoard, Display);
+            exit(EXIT_SUCCESS);
+            break;
+        // the window is drawn again when it is shown
+        case SDL_WINDOWEVENT:
+            Display.invalidate();
+            break;
+        default:
+            break;
+        }
+    }
+
+    // esc touch
+    if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_ESCAPE) {
+        quit(spriteBoard, Display);
+        exit(EXIT_SUCCESS);
+    }
+}
+
+/**
+ * @brief Read the direction of the arrow pressed in the last event.
+ *
+ * @param event
+ * @return dir NONE if the last event is not an arrow
+ */
+dir readInput(const SDL_Event &event) {
+
+    if (event.type != SDL_KEYDOWN)
+        return NONE;
+    switch (event.key.keysym.sym) {
+    // left arrow touch
+    case SDLK_LEFT:
+        return LEFT;
+    // right arrow touch
+    case SDLK_RIGHT:
+        return RIGHT;
+    // up arrow touch
+    case SDLK_UP:
+        return UP;
+    // down arrow touch
+    case SDLK_DOWN:
+        return DOWN;
+    default:
+        return NONE;
+    }
+}
+
+/**
+ * @brief Wait for the end of a frame of 10ms.
+ *
+ * @param options
+ * @param fps_start the time of the beginning of the frame
+ */
+void waitFrame(const Options &options, Uint64 fps_start) {
+
+    // fps
+    if (options.speed != SPEED_MAX) {
+        Uint64 fps_end = SDL_GetTicks();
+        float elapsed = (fps_end - fps_start) /
+                        (float)SDL_GetPerformanceFrequency() * 1000.0f;
+
+        SDL_Delay(floor(10.000f - elapsed));
+    }
+}
+
+/**
+ * @brief Play the ticks of a life and draw its frames between them, until
+ * the level is cleared or pacman dies.
+ *
+ * @param Sim
+ * @param Display
+ * @param spriteBoard
+ * @param options
+ * @param list the drawings of the frames
+ * @param count the number of frame
+ * @param highScore
+ * @param event the last event
+ * @param Autopilot plays pacman instead of the keyboard, nullptr to let the
+ * player play
+ * @return stepResult the end of the life
+ */
+stepResult playLife(simulation &Sim, display &Display, SDL_Surface *spriteBoard,
+                    const Options &options, DrawList &list, int &count,
+                    int highScore, SDL_Event &event, mcts *Autopilot) {
+
+    pacman &Pacman = Sim.getPacman();
+    // ticks played in the current frame and number of frames
+    int frameTick = 0, frame = 0;
+    Uint64 fps_start = 0;
+    while (true) {
+
+        // fps management
+        if (frameTick == 0)
+            fps_start = SDL_GetTicks();
+
+        // keyboard management
+        pollLife(event, spriteBoard, Display);
+
+        // play one tick
+        dir input = Autopilot != nullptr ? Autopilot->play(Sim)
+                                         : readInput(event);
+        if (recording.fileName != nullptr)
+            recording.Replay.record(input, Sim);
+        stepResult result = Sim.step(input);
+        if (result == STEP_LEVEL_CLEARED || result == STEP_DEATH ||
+            result == STEP_GAME_OVER)
+            return result;
+
+        // end of the frame
+        if (++frameTick < options.speed)
+            continue;
+        frameTick = 0;
+
+        // display updated board
+        if (result == STEP_PLAY && options.render != RENDER_NONE &&
+            frame++ % options.render == 0) {
+            count = buildFrame(list, count, Pacman, Sim.getGhosts(),
+                               Sim.getDotList(), Sim.getPowerupList(),
+                               Sim.getFruit().getFruit(), Pacman.getScore(),
+                               highScore, PACMAN_LIVE, true, Sim.getLevel(),
+                               Sim.getClock());
+            Display.show(list);
+        }
+
+        waitFrame(options, fps_start);
+    }
+}
+
+/**
+ * @brief Play a life as playLife, with the simulation on a thread of its own.
+ * The simulation builds the frames in a triple buffer and the main thread,
+ * which keeps the events and the display as SDL requires, shows the latest
+ * one: a slow frame does not delay the ticks.
+ *
+ * @param Sim
+ * @param Display
+ * @param spriteBoard
+ * @param options
+ * @param count the number of frame
+ * @param highScore
+ * @param event the last event
+ * @param Autopilot plays pacman on the thread of the simulation, nullptr to
+ * let the player play
+ * @return stepResult the end of the life
+ */
+stepResult playLifePipelined(simulation &Sim, display &Display,
+                             SDL_Surface *spriteBoard, const Options &options,
+                             int &count, int highScore, SDL_Event &event,
+                             mcts *Autopilot) {
+
+    frameBuffer frames;
+    // direction pressed, read by the simulation at each tick
+    std::atomic<int> input(NONE);
+    std::atomic<bool> stop(false), done(false);
+    stepResult result = STEP_PLAY;
+
+    std::thread simulationThread([&]() {
+        pacman &Pacman = Sim.getPacman();
+        // ticks played in the current frame and number of frames
+        int frameTick = 0, frame = 0;
+        Uint64 fps_start = 0;
+        while (!stop) {
+
+            // fps management
+            if (frameTick == 0)
+                fps_start = SDL_GetTicks();
+
+            // play one tick
+            dir tickInput = Autopilot != nullptr ? Autopilot->play(Sim)
+                                                 : dir(input.load());
+            if (recording.fileName != nullptr)
+                recording.Replay.record(tickInput, Sim);
+            result = Sim.step(tickInput);
+            if (result == STEP_LEVEL_CLEARED || result == STEP_DEATH ||
+                result == STEP_GAME_OVER)
+                break;
+
+            // end of the frame
+            if (++frameTick < options.speed)
+                continue;
+            frameTick = 0;
+
+            // give the updated board to the display
+            if (result == STEP_PLAY && options.render != RENDER_NONE &&
+                frame++ % options.render == 0) {
+                count = buildFrame(
+                    frames.back(), count, Pacman, Sim.getGhosts(),
+                    Sim.getDotList(), Sim.getPowerupList(),
+                    Sim.getFruit().getFruit(), Pacman.getScore(), highScore,
+                    PACMAN_LIVE, true, Sim.getLevel(), Sim.getClock());
+                frames.publish();
+            }
+
+            waitFrame(options, fps_start);
+        }
+        done = true;
+    });
+
+    while (!done) {
+        // keyboard management, the game is left after the simulation stops
+        if (SDL_PollEvent(&event) && event.type == SDL_WINDOWEVENT)
+            Display.invalidate();
+        if (event.type == SDL_QUIT ||
+            (event.type == SDL_KEYDOWN &&
+             event.key.keysym.sym == SDLK_ESCAPE)) {
+            stop = true;
+            simulationThread.join();
+            quit(spriteBoard, Display);
+            exit(EXIT_SUCCESS);
+        }
+        input = readInput(event);
+
+        // display the latest board
+        if (frames.consume())
+            Display.show(frames.front());
+        else
+            SDL_Delay(1);
+    }
+
+    simulationThread.join();
+    return result;
+}
+
+int main(int argc, char **argv) {
+
+    Options options = readOptions(argc, argv);
+    if (options.replay != nullptr)
+        return playReplay(options.replay);
 
     // initialize SDL
     if (SDL_Init(SDL_INIT_VIDEO) != 0) {
@@ -27,20 +473,30 @@ int main() {
 
     // initialize SDL window
     SDL_Window *Window = nullptr;
-    SDL_Surface *windowSurf = nullptr;
     SDL_Surface *spriteBoard = nullptr;
-    dir currentDir = NONE;
-    init(&Window, &windowSurf, &spriteBoard);
+    init(&Window, &spriteBoard);
+    display Display;
+    if (spriteBoard == nullptr ||
+        !Display.open(Window, spriteBoard, options.Backend)) {
+
+        std::cerr << "Unable to open the display: " << SDL_GetError()
+                  << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    // drawings of the current frame
+    DrawList list;
 
     // Keyboard
     SDL_Event event;
 
     // initialize game
-    pacman Pacman;
-    board Board;
-    Board.load();
-    Board.transpose();
-    Board.setItem();
+    simulation Sim(options.seed);
+    Sim.load();
+    recording.fileName = options.record;
+    recording.Sim = &Sim;
+    std::unique_ptr<mcts> Autopilot;
+    if (options.autopilot)
+        Autopilot = std::make_unique<mcts>(LEVEL_FILE, options.mcts);
 
     // read highscore if exist or create it
     int highScore = 0;
@@ -61,18 +517,22 @@ int main() {
 
     // Game
     bool game = true;
-    bool next_level = true;
     bool menu = true;
     while (game) {
 
         // Intro
         while (menu) {
             // display intro
-            intro(&windowSurf, &spriteBoard, highScore);
-            SDL_UpdateWindowSurface(Window);
+            buildIntro(list, highScore);
+            Display.show(list);
+
+            // do not wait for the player at full speed or with the autopilot
+            if (options.speed == SPEED_MAX || options.autopilot)
+                menu = false;
 
-            // keyboard management
-            SDL_PollEvent(&event);
+            // keyboard management, the window is drawn again when it is shown
+            if (SDL_PollEvent(&event) && event.type == SDL_WINDOWEVENT)
+                Display.invalidate();
             // return touch
             if (event.type == SDL_KEYDOWN &&
                 event.key.keysym.sym == SDLK_RETURN)
@@ -82,241 +542,120 @@ int main() {
                       event.key.keysym.sym == SDLK_ESCAPE) ||
                      event.type == SDL_QUIT) {
 
-                quit(std::vector<Coordinate>(), std::vector<Coordinate>(),
-                     std::vector<std::shared_ptr<ghost>>(), pacman(), Board,
-                     spriteBoard, windowSurf);
+                quit(spriteBoard, Display);
                 exit(EXIT_SUCCESS);
             }
         }
 
         // Level
-        int curLevel = 1;
+        Sim.newGame();
+        if (options.record != nullptr)
+            recording.Replay.start(Sim, LEVEL_FILE);
         bool level = true;
         while (level) {
 
-            // initialize next level
-            if (next_level == true) {
-                // reload all the items
-                Board.setItem();
-                next_level = false;
-            }
-
-            // initialize pacman and ghost
-            Pacman.init();
-            std::vector<std::shared_ptr<ghost>> vecGhost;
-            for (int i = 0; i < 4; i++) {
-                std::shared_ptr<ghost> Ghost = std::make_shared<ghost>();
-                Ghost->setGhost(color(i));
-                vecGhost.push_back(Ghost);
-            }
-
-            // retrieve item list
-            std::vector<Coordinate> vecDot = Board.getDotList();
-            std::vector<Coordinate> vecPowerup = Board.getPowerupList();
-            fruit Fruit;
+            // initialize pacman, ghost and items
+            Sim.startLife();
+            pacman &Pacman = Sim.getPacman();
 
             // display initial board
             int count = 0;
-            count = draw(&windowSurf, &spriteBoard, count, Pacman, vecGhost,
-                         vecDot, vecPowerup, _NONE, Pacman.getScore(),
-                         highScore, PACMAN_LIVE, false, curLevel);
-            SDL_UpdateWindowSurface(Window);
+            count = buildFrame(list, count, Pacman, Sim.getGhosts(),
+                               Sim.getDotList(), Sim.getPowerupList(), _NONE,
+                               Pacman.getScore(), highScore, PACMAN_LIVE,
+                               false, Sim.getLevel(), Sim.getClock());
+            Display.show(list);
 
-            bool life = true, start = false;
-            // Life
-            while (life) {
-
-                // fps management
-                Uint64 fps_start = SDL_GetTicks();
-
-                // event management
-                if (life && SDL_PollEvent(&event)) {
-                    switch (event.type) {
-                    // leave the game
-                    case SDL_QUIT:
-                        quit(vecDot, vecPowerup, vecGhost, Pacman, Board,
-                             spriteBoard, windowSurf);
-                        exit(EXIT_SUCCESS);
-                        break;
-                    default:
-                        break;
-                    }
-                }
-
-                // keyboard management
-                // esc touch
-                if (event.type == SDL_KEYDOWN &&
-                    event.key.keysym.sym == SDLK_ESCAPE) {
-
-                    quit(vecDot, vecPowerup, vecGhost, Pacman, Board,
-                         spriteBoard, windowSurf);
-                    exit(EXIT_SUCCESS);
-                }
-                // left arrow touch
-                else if (event.type == SDL_KEYDOWN &&
-                         event.key.keysym.sym == SDLK_LEFT) {
-
-                    start = true;
-                    currentDir = LEFT;
-                }
-                // right arrow touch
-                else if (event.type == SDL_KEYDOWN &&
-                         event.key.keysym.sym == SDLK_RIGHT) {
-
-                    start = true;
-                    currentDir = RIGHT;
-                }
-                // up arrow touch
-                else if (event.type == SDL_KEYDOWN &&
-                         event.key.keysym.sym == SDLK_UP) {
+            // count the copies of the board made by the gameplay
+            DEB(size_t copyCount = grid::getCopyCount());
+            DEB(tick_t startTick = Sim.getClock().now());
 
-                    start = true;
-                    currentDir = UP;
+            // Life
+            stepResult result =
+                options.pipeline
+                    ? playLifePipelined(Sim, Display, spriteBoard, options,
+                                        count, highScore, event,
+                                        Autopilot.get())
+                    : playLife(Sim, Display, spriteBoard, options, list, count,
+                               highScore, event, Autopilot.get());
+
+            // loose statement
+            if (result == STEP_DEATH || result == STEP_GAME_OVER) {
+
+                // death animation
+                int i;
+                for (i = 0; i < 10 && options.render != RENDER_NONE; i++) {
+                    Uint64 fps_start = SDL_GetTicks();
+                    count = buildFrame(
+                        list, count, Pacman, Sim.getGhosts(), Sim.getDotList(),
+                        Sim.getPowerupList(), Sim.getFruit().getFruit(),
+                        Pacman.getScore(), highScore, PACMAN_DEATH * i, true,
+                        Sim.getLevel(), Sim.getClock());
+                    Display.show(list);
+                    Uint64 fps_end = SDL_GetTicks();
+                    float elapsed =
+                        (fps_end - fps_start) /
+                        (float)SDL_GetPerformanceFrequency() * 1000.0f;
+
+                    // slow the animation
+                    if (options.speed != SPEED_MAX)
+                        SDL_Delay(int((66.668f - elapsed) / options.speed));
                 }
-                // down arrow touch
-                else if (event.type == SDL_KEYDOWN &&
-                         event.key.keysym.sym == SDLK_DOWN) {
 
-                    start = true;
-                    currentDir = DOWN;
-                }
+                // no more life, reset level and score
+                if (result == STEP_GAME_OVER) {
 
-                // press any key to start the game
-                if (start) {
-
-                    // pacman movement management
-                    if (Pacman.waitSquareCenter() == true)
-                        Pacman.updateDir(Board.getBoard(), currentDir);
-                    Pacman.updatePos();
-                    Pacman.updateSquare(Board.getBoard(), vecGhost, &Fruit);
-                    // pacman eat fruit management
-                    if (Fruit.updateFruit(Board.getBoard(),
-                                          Pacman.getDotCounter(),
-                                          Pacman.getFruitEaten()) == EXCEED) {
-                        Pacman.resetDotCounter();
-                    }
+                    saveRecording();
 
-                    // ghost movement management
-                    for (auto Ghost : vecGhost) {
-
-                        if (Ghost->waitSquareCenter() == true)
-                            Ghost->updateDir(
-                                Board.getBoard(),
-                                Pacman.getPos().first / SCALE_PIXEL,
-                                Pacman.getPos().second / SCALE_PIXEL,
-                                Pacman.getLastDir(), curLevel,
-                                Pacman.getDotCounterLevel(),
-                                Pacman.getRemainingLife(),
-                                Pacman.getNoEatenDotTimer());
-                        Ghost->updatePos();
-                    }
+                    // save highscore
+                    if (Pacman.getScore() > size_t(highScore)) {
 
-                    // update item on the board
-                    vecDot = Board.getDotList();
-                    vecPowerup = Board.getPowerupList();
-
-                    // win statement
-                    if (vecDot.size() == 0 && vecPowerup.size() == 0) {
-                        // next level
-                        curLevel++;
-                        next_level = true;
-                        life = false;
-                        break;
+                        highScore = Pacman.getScore();
+                        std::ofstream file;
+                        file.open("bin/highscore.txt");
+                        file << highScore;
+                        file.close();
                     }
 
-                    // loose statement
-                    if (Pacman.ghostCollision(vecGhost)) {
-
-                        // death animation
-                        int i;
-                        for (i = 0; i < 10; i++) {
-                            count = draw(&windowSurf, &spriteBoard, count,
-                                         Pacman, vecGhost, vecDot, vecPowerup,
-                                         Fruit.getFruit(), Pacman.getScore(),
-                                         highScore, PACMAN_DEATH * i, start,
-                                         curLevel);
-                            SDL_UpdateWindowSurface(Window);
-                            Uint64 fps_end = SDL_GetTicks();
-                            float elapsed =
-                                (fps_end - fps_start) /
-                                (float)SDL_GetPerformanceFrequency() * 1000.0f;
-
-                            // slow the animation
-                            SDL_Delay(int(66.668f - elapsed));
+                    // print game over screen
+                    bool gameOverScreen =
+                        options.speed != SPEED_MAX && !options.autopilot;
+                    while (gameOverScreen) {
+
+                        buildGameOver(list, Pacman.getScore(), highScore);
+                        Display.show(list);
+
+                        // keyboard management
+                        if (SDL_PollEvent(&event) &&
+                            event.type == SDL_WINDOWEVENT)
+                            Display.invalidate();
+                        // return touch
+                        if (event.type == SDL_KEYDOWN &&
+                            event.key.keysym.sym == SDLK_RETURN)
+                            gameOverScreen = false;
+                        // esc touch
+                        else if (event.type == SDL_KEYDOWN &&
+                                 event.key.keysym.sym == SDLK_ESCAPE) {
+                            quit(spriteBoard, Display);
+                            return EXIT_SUCCESS;
                         }
-
-                        // loose a life
-                        Pacman.looseLife();
-
-                        // no more life, reset level and score
-                        if (Pacman.getRemainingLife() == 0) {
-
-                            // save highscore
-                            if (Pacman.getScore() > size_t(highScore)) {
-
-                                highScore = Pacman.getScore();
-                                std::ofstream file;
-                                file.open("bin/highscore.txt");
-                                file << highScore;
-                                file.close();
-                            }
-
-                            // print game over screen
-                            bool gameOverScreen = true;
-                            while (gameOverScreen) {
-
-                                gameOver(&windowSurf, &spriteBoard,
-                                         Pacman.getScore(), highScore);
-                                SDL_UpdateWindowSurface(Window);
-
-                                // keyboard management
-                                SDL_PollEvent(&event);
-                                // return touch
-                                if (event.type == SDL_KEYDOWN &&
-                                    event.key.keysym.sym == SDLK_RETURN)
-                                    gameOverScreen = false;
-                                // esc touch
-                                else if (event.type == SDL_KEYDOWN &&
-                                         event.key.keysym.sym == SDLK_ESCAPE) {
-                                    SDL_Quit();
-                                    return EXIT_SUCCESS;
-                                }
-                                // close window
-                                else if (event.type == SDL_QUIT) {
-                                    SDL_Quit();
-                                    return EXIT_SUCCESS;
-                                }
-                            }
-
-                            // beginning level
-                            Pacman.reset();
-                            next_level = true;
-                            life = false;
-                            level = false;
-                            menu = true;
-                            break;
+                        // close window
+                        else if (event.type == SDL_QUIT) {
+                            quit(spriteBoard, Display);
+                            return EXIT_SUCCESS;
                         }
-
-                        // next life
-                        life = false;
-                        break;
                     }
 
-                    // display updated board
-                    count = draw(&windowSurf, &spriteBoard, count, Pacman,
-                                 vecGhost, vecDot, vecPowerup, Fruit.getFruit(),
-                                 Pacman.getScore(), highScore, PACMAN_LIVE,
-                                 start, curLevel);
-                    SDL_UpdateWindowSurface(Window);
+                    // beginning level
+                    level = false;
+                    menu = true;
                 }
-
-                Uint64 fps_end = SDL_GetTicks();
-                float elapsed = (fps_end - fps_start) /
-                                (float)SDL_GetPerformanceFrequency() * 1000.0f;
-
-                // fps
-                SDL_Delay(floor(10.000f - elapsed));
             }
+
+            DEB(std::cout << "\033[92m" << grid::getCopyCount() - copyCount
+                          << " board copies in "
+                          << Sim.getClock().now() - startTick
+                          << " ticks\033[0m" << std::endl);
         }
     }
 }
@@ -0,0 +1,325 @@
+#include "mcts.h"
+#include <cmath>
+#include <thread>
+
+/**
+ * @brief Get the directions pacman can take from the square where he is,
+ * through the tunnels too.
+ *
+ * @param Sim
+ * @param lastDir the direction pacman comes from, to not go back, NONE to
+ * get all the directions
+ * @return unsigned DIR_MASK of each direction
+ */
+static unsigned getMoves(simulation &Sim, dir lastDir) {
+
+    std::pair<size_t, size_t> square = Sim.getPacman().getSquare();
+    const level &Level = Sim.getBoard().getLevel();
+    unsigned moves = Sim.getBoard().getBits().getLegalMoves(
+        square.first, square.second, lastDir);
+    // pacman goes out of a tunnel on the other side
+    if (Level.isTunnel(square.second)) {
+        if (square.first == 0 && lastDir != RIGHT)
+            moves |= DIR_MASK(LEFT);
+        if (square.first == Level.getWidth() - 1 && lastDir != LEFT)
+            moves |= DIR_MASK(RIGHT);
+    }
+    return moves;
+}
+
+/**
+ * @brief Move pacman to the center of the next square.
+ *
+ * @param Sim
+ * @param move
+ * @return stepResult the result of the last step
+ */
+static stepResult playMove(simulation &Sim, dir move) {
+
+    stepResult step = Sim.step(move);
+    for (int tick = 1; step == STEP_PLAY && tick < MCTS_MAX_MOVE_TICKS &&
+                       !Sim.getPacman().isAtSquareCenter();
+         tick++)
+        step = Sim.step(NONE);
+    return step;
+}
+
+/**
+ * @brief Find the item the nearest to pacman.
+ *
+ * @param Sim
+ * @param paths
+ * @param target the item, the square of pacman if there is none
+ * @return int the distance to the item, UNREACHABLE if there is none
+ */
+static int findNearestItem(simulation &Sim, const pathTable *paths,
+                           Coordinate &target) {
+
+    std::pair<size_t, size_t> square = Sim.getPacman().getSquare();
+    int bestDistance = UNREACHABLE;
+    target = {int(square.first), int(square.second)};
+    for (auto *vecItem : {&Sim.getDotList(), &Sim.getPowerupList()}) {
+        for (auto &coord : *vecItem) {
+            int distance = paths->getDistance(square.first, square.second,
+                                              coord.x, coord.y);
+            // the order of the list depends on the snapshots restored
+            // before, the ties are broken by the position of the items
+            if (distance != -1 &&
+                (distance < bestDistance ||
+                 (distance == bestDistance &&
+                  std::make_pair(coord.y, coord.x) <
+                      std::make_pair(target.y, target.x)))) {
+                bestDistance = distance;
+                target = coord;
+            }
+        }
+    }
+    return bestDistance;
+}
+
+/**
+ * @brief Choose a move of a rollout: go to the nearest item, or go on in a
+ * random direction without going back.
+ *
+ * @param Sim
+ * @param random
+ * @return dir
+ */
+static dir rolloutMove(simulation &Sim, rng &random) {
+
+    unsigned moves = getMoves(Sim, Sim.getPacman().getLastDir());
+    // dead end
+    if (moves == 0)
+        moves = getMoves(Sim, NONE);
+
+    const pathTable *paths = Sim.getBoard().getBoard().getPaths();
+    if (paths != nullptr && random.bounded(MCTS_RANDOM_ROLLOUT) != 0) {
+        std::pair<size_t, size_t> square = Sim.getPacman().getSquare();
+        Coordinate target;
+        findNearestItem(Sim, paths, target);
+        dir next = paths->getNextDir(square.first, square.second, target.x,
+                                     target.y);
+        if (next != NONE && (moves & DIR_MASK(next)))
+            return next;
+    }
+
+    // random direction among the allowed ones
+    int nbMoves = __builtin_popcount(moves);
+    if (nbMoves == 0)
+        return NONE;
+    return nthDir(moves, random.bounded(nbMoves));
+}
+
+/**
+ * @brief Choose a direction without search: go on if it is possible.
+ *
+ * @param Sim
+ * @param moves
+ * @return dir
+ */
+static dir keepGoing(simulation &Sim, unsigned moves) {
+
+    dir lastDir = Sim.getPacman().getLastDir();
+    if (lastDir != NONE && (moves & DIR_MASK(lastDir)))
+        return lastDir;
+    return moves == 0 ? NONE : dir(__builtin_ctz(moves));
+}
+
+mcts::mcts(const std::string &levelName, const MctsOptions &options)
+    : _options(options), _rootScore(0), _iterations(0) {
+
+    if (_options.threads == 0)
+        _options.threads = 1;
+
+    // the simulations share the path tables of the first one
+    for (size_t i = 0; i < _options.threads; i++) {
+        _workers.push_back(std::make_unique<worker>());
+        _workers.back()->Sim = std::make_unique<simulation>();
+        _workers.back()->Sim->load(
+            levelName, _workers[0]->Sim->getBoard().getPathTables());
+        _workers.back()->tree.reserve(MCTS_MAX_NODES);
+        _workers.back()->iterations = 0;
+    }
+}
+
+mcts::~mcts() {}
+
+dir mcts::play(simulation &Sim) {
+
+    if (!Sim.getPacman().isAtSquareCenter())
+        return NONE;
+
+    // a single move or a game which can not be searched
+    unsigned moves = getMoves(Sim, NONE);
+    if (__builtin_popcount(moves) <= 1 || !Sim.save(_root) ||
+        !_workers[0]->Sim->restore(_root))
+        return keepGoing(Sim, moves);
+
+    _rootScore = Sim.getPacman().getScore();
+    _deadline = std::chrono::steady_clock::now() +
+                std::chrono::milliseconds(_options.time);
+    size_t iterations =
+        (_options.iterations + _options.threads - 1) / _options.threads;
+    uint64_t hash = Sim.getHash();
+    for (size_t i = 0; i < _workers.size(); i++) {
+        worker &Worker = *_workers[i];
+        Worker.tree.clear();
+        Worker.tree.push_back({0, 0, 0, 0, NONE, false, false, 0});
+        // the rollouts only depend on the state of the game
+        Worker.random.setSeed(hash + i);
+        Worker.iterations = 0;
+    }
+
+    // the calling thread searches too
+    std::vector<std::thread> vecThread;
+    for (size_t i = 1; i < _workers.size(); i++)
+        vecThread.emplace_back(
+            [this, i, iterations]() { search(*_workers[i], iterations); });
+    search(*_workers[0], iterations);
+    for (auto &thread : vecThread)
+        thread.join();
+
+    // the most visited first move of all the trees
+    uint64_t visits[NONE] = {0};
+    double value[NONE] = {0};
+    _iterations = 0;
+    for (auto &Worker : _workers) {
+        const MctsNode &root = Worker->tree[0];
+        for (uint32_t i = 0; i < root.nbChildren; i++) {
+            const MctsNode &child = Worker->tree[root.firstChild + i];
+            visits[child.move] += child.visits;
+            value[child.move] += child.value;
+        }
+        _iterations += Worker->iterations;
+    }
+    dir best = keepGoing(Sim, moves);
+    for (dir d : {LEFT, RIGHT, UP, DOWN}) {
+        if (visits[d] > visits[best] ||
+            (visits[d] == visits[best] && value[d] > value[best]))
+            best = d;
+    }
+    return best;
+}
+
+size_t mcts::getIterations() const { return _iterations; }
+
+void mcts::search(worker &Worker, size_t iterations) {
+
+    // at least one rollout, even if the time is spent
+    do {
+        iterate(Worker);
+        Worker.iterations++;
+    } while ((iterations == 0 || Worker.iterations < iterations) &&
+             std::chrono::steady_clock::now() < _deadline);
+}
+
+void mcts::iterate(worker &Worker) {
+
+    simulation &Sim = *Worker.Sim;
+    std::vector<MctsNode> &tree = Worker.tree;
+    Sim.restore(_root);
+
+    // score of the moves, the later points weigh less
+    size_t score = _rootScore;
+    double gain = 0, weight = 1;
+    auto addScore = [&]() {
+        size_t newScore = Sim.getPacman().getScore();
+        gain += weight * (newScore - score);
+        weight *= MCTS_DISCOUNT;
+        score = newScore;
+    };
+
+    // go down the tree until a new node
+    uint32_t index = 0;
+    bool newNode = false, end = false;
+    float value = 0;
+    Worker.path.clear();
+    Worker.path.push_back(index);
+    while (!newNode) {
+
+        if (tree[index].terminal) {
+            value = tree[index].terminalValue;
+            end = true;
+            break;
+        }
+        // the moves from the square are added at the first visit, the tree
+        // stops growing when it is full
+        if (!tree[index].expanded) {
+            if (tree.size() + NONE > MCTS_MAX_NODES)
+                break;
+            unsigned moves = getMoves(Sim, NONE);
+            tree[index].firstChild = tree.size();
+            tree[index].nbChildren = __builtin_popcount(moves);
+            tree[index].expanded = true;
+            for (dir d : {LEFT, RIGHT, UP, DOWN})
+                if (moves & DIR_MASK(d))
+                    tree.push_back({0, 0, 0, 0, uint8_t(d), false, false, 0});
+        }
+        const MctsNode &node = tree[index];
+        if (node.nbChildren == 0)
+            break;
+
+        // a child never visited first, then the best by UCT
+        uint32_t best = node.firstChild;
+        double bestScore = -1;
+        double logVisits = std::log(double(node.visits));
+        for (uint32_t i = node.firstChild;
+             i < node.firstChild + node.nbChildren; i++) {
+            if (tree[i].visits == 0) {
+                best = i;
+                break;
+            }
+            double uct = tree[i].value / tree[i].visits +
+                         MCTS_EXPLORATION *
+                             std::sqrt(logVisits / tree[i].visits);
+            if (uct > bestScore) {
+                bestScore = uct;
+                best = i;
+            }
+        }
+        newNode = tree[best].visits == 0;
+        index = best;
+        Worker.path.push_back(index);
+
+        stepResult step = playMove(Sim, dir(tree[index].move));
+        addScore();
+        if (step == STEP_DEATH || step == STEP_GAME_OVER ||
+            step == STEP_LEVEL_CLEARED) {
+            tree[index].terminal = true;
+            tree[index].terminalValue = step == STEP_LEVEL_CLEARED;
+            value = tree[index].terminalValue;
+            end = true;
+            break;
+        }
+    }
+
+    // rollout from the new node
+    for (int i = 0; !end && i < MCTS_ROLLOUT_MOVES; i++) {
+        stepResult step = playMove(Sim, rolloutMove(Sim, Worker.random));
+        addScore();
+        if (step == STEP_DEATH || step == STEP_GAME_OVER ||
+            step == STEP_LEVEL_CLEARED) {
+            value = step == STEP_LEVEL_CLEARED;
+            end = true;
+        }
+    }
+    // a rollout without points is still better near an item
+    if (!end) {
+        const pathTable *paths = Sim.getBoard().getBoard().getPaths();
+        Coordinate target;
+        int distance = paths == nullptr
+                           ? UNREACHABLE
+                           : findNearestItem(Sim, paths, target);
+        value = 0.5 +
+                (0.5 - MCTS_DISTANCE_VALUE) *
+                    std::min<double>(gain, MCTS_SCORE_SCALE) /
+                    MCTS_SCORE_SCALE +
+                MCTS_DISTANCE_VALUE *
+                    std::max(0.0, 1 - double(distance) / MCTS_DISTANCE_SCALE);
+    }
+
+    for (uint32_t i : Worker.path) {
+        tree[i].visits++;
+        tree[i].value += value;
+    }
+}
@@ -1,6 +1,8 @@
 #include "pacman.h"
 
-pacman::pacman() {
+pacman::pacman(const gameClock &clock, const level &Level) {
+    _clock = &clock;
+    _level = &Level;
     init();
     reset();
 }
@@ -8,10 +10,10 @@ pacman::pacman() {
 pacman::~pacman() {}
 
 void pacman::init() {
-    _xBoard = PACMAN_INIT_X;
-    _yBoard = PACMAN_INIT_Y;
-    _xPixel = PACMAN_INIT_X * SCALE_PIXEL + PACMAN_CENTER_X;
-    _yPixel = PACMAN_INIT_Y * SCALE_PIXEL + PACMAN_CENTER_Y;
+    _xBoard = _level->getPacmanSpawn().x;
+    _yBoard = _level->getPacmanSpawn().y;
+    _xPixel = _xBoard * SCALE_PIXEL + PACMAN_CENTER_X;
+    _yPixel = _yBoard * SCALE_PIXEL + PACMAN_CENTER_Y;
     _lastDir = NONE;
     _oldDir = NONE;
     _powerup = false;
@@ -19,19 +21,29 @@ void pacman::init() {
     _ghostEatenScore = 0;
     _fruitEaten = 0;
     _dotCounterLevel = 0;
-    noEatenDotTimer1 = std::chrono::steady_clock::now();
+    noEatenDotTimer1 = _clock->now();
 }
 
 void pacman::reset() {
     _score = 0;
     _dotCounter = 0;
     _remainingLife = DEFAULT_LIVES;
+    // nothing is kept from the previous game
+    _eatenFruit.clear();
+    _fruitEatenScore = 0;
+    _ghostEatenColor = RED;
+    powerupTimer1 = 0;
+    fruitEatenTimer1 = 0;
 }
 
 std::pair<size_t, size_t> pacman::getPos() {
     return std::make_pair(_xPixel, _yPixel);
 }
 
+std::pair<size_t, size_t> pacman::getSquare() const {
+    return std::make_pair(_xBoard, _yBoard);
+}
+
 void pacman::updatePos() {
     // normal speed
     switch (_lastDir) {
@@ -56,41 +68,47 @@ void pacman::updatePos() {
     }
 }
 
-bool pacman::waitSquareCenter() {
+bool pacman::isAtSquareCenter() const {
 
     size_t xCenter = _xBoard * SCALE_PIXEL + PACMAN_CENTER_X,
            yCenter = _yBoard * SCALE_PIXEL + PACMAN_CENTER_Y;
 
     // speed of 2 pixels per frame
-    if (_lastDir == LEFT &&
-        _xPixel - PACMAN_SPEED <= xCenter + PACMAN_RANGE_CENTER) {
-        _xPixel = _xBoard * SCALE_PIXEL + PACMAN_CENTER_X;
-        return true;
-    } else if (_lastDir == RIGHT &&
-               _xPixel + PACMAN_SPEED >= xCenter - PACMAN_RANGE_CENTER) {
+    switch (_lastDir) {
+    case LEFT:
+        return _xPixel - PACMAN_SPEED <= xCenter + PACMAN_RANGE_CENTER;
+    case RIGHT:
+        return _xPixel + PACMAN_SPEED >= xCenter - PACMAN_RANGE_CENTER;
+    case UP:
+        return _yPixel + PACMAN_SPEED <= yCenter + PACMAN_RANGE_CENTER;
+    case DOWN:
+        return _yPixel + PACMAN_SPEED >= yCenter - PACMAN_RANGE_CENTER;
+    case NONE:
+        break;
+    }
+    return true;
+}
+
+bool pacman::waitSquareCenter() {
+
+    if (!isAtSquareCenter())
+        return false;
+
+    // snap the sprite on the center along its direction
+    if (_lastDir == LEFT || _lastDir == RIGHT)
         _xPixel = _xBoard * SCALE_PIXEL + PACMAN_CENTER_X;
-        return true;
-    } else if (_lastDir == UP &&
-               _yPixel + PACMAN_SPEED <= yCenter + PACMAN_RANGE_CENTER) {
-        _yPixel = _yBoard * SCALE_PIXEL + PACMAN_CENTER_Y;
-        return true;
-    } else if (_lastDir == DOWN &&
-               _yPixel + PACMAN_SPEED >= yCenter - PACMAN_RANGE_CENTER) {
+    else if (_lastDir == UP || _lastDir == DOWN)
         _yPixel = _yBoard * SCALE_PIXEL + PACMAN_CENTER_Y;
-        return true;
-    } else if (_lastDir == NONE)
-        return true;
-
-    return false;
+    return true;
 }
 
 dir pacman::getLastDir() { return _lastDir; }
 
-void pacman::updateDir(
-    std::vector<std::vector<std::shared_ptr<square>>> vecBoard,
-    dir currentDir) {
+void pacman::updateDir(gridView vecBoard, dir currentDir) {
 
-    if (_xBoard > 20 || _yBoard == 0 || _yBoard >= 26) {
+    size_t xMax = vecBoard.getWidth() - 1, yMax = vecBoard.getHeight() - 1;
+
+    if (_xBoard > xMax || _yBoard == 0 || _yBoard >= yMax) {
         std::cerr << "Pacman out of the board in updateDir" << std::endl;
         exit(EXIT_FAILURE);
     }
@@ -99,17 +117,17 @@ void pacman::updateDir(
 
     case LEFT:
         // out of the board
-        if (_xBoard == 0 && _yBoard != 13) {
+        if (_xBoard == 0 && !_level->isTunnel(_yBoard)) {
             _lastDir = NONE;
             break;
         }
         // teleportation
-        else if (_xBoard == 0 && _yBoard == 13) {
-            _xBoard = 20;
-            _xPixel = 20 * SCALE_PIXEL + PACMAN_CENTER_X;
+        else if (_xBoard == 0) {
+            _xBoard = xMax;
+            _xPixel = xMax * SCALE_PIXEL + PACMAN_CENTER_X;
         }
 
-        if (vecBoard[_xBoard - 1][_yBoard]->getState() == HALL) {
+        if (vecBoard.at(_xBoard - 1, _yBoard).getState() == HALL) {
             _xBoard--;
             _lastDir = LEFT;
         } else {
@@ -121,17 +139,17 @@ void pacman::updateDir(
 
     case RIGHT:
         // out of the board
-        if (_xBoard >= 20 && _yBoard != 13) {
+        if (_xBoard >= xMax && !_level->isTunnel(_yBoard)) {
             _lastDir = NONE;
             break;
         }
         // teleportation
-        else if (_xBoard == 20 && _yBoard == 13) {
+        else if (_xBoard == xMax) {
             _xBoard = 0;
             _xPixel = PACMAN_CENTER_X;
         }
 
-        if (vecBoard[_xBoard + 1][_yBoard]->getState() == HALL) {
+        if (vecBoard.at(_xBoard + 1, _yBoard).getState() == HALL) {
             _xBoard++;
             _lastDir = RIGHT;
         } else {
@@ -148,7 +166,7 @@ void pacman::updateDir(
             break;
         }
 
-        if (vecBoard[_xBoard][_yBoard - 1]->getState() == HALL) {
+        if (vecBoard.at(_xBoard, _yBoard - 1).getState() == HALL) {
             _yBoard--;
             _lastDir = UP;
 
@@ -161,12 +179,12 @@ void pacman::updateDir(
 
     case DOWN:
         // out of the board
-        if (_yBoard >= 26) {
+        if (_yBoard >= yMax) {
             _lastDir = NONE;
             break;
         }
 
-        if (vecBoard[_xBoard][_yBoard + 1]->getState() == HALL) {
+        if (vecBoard.at(_xBoard, _yBoard + 1).getState() == HALL) {
             _yBoard++;
             _lastDir = DOWN;
 
@@ -182,17 +200,16 @@ void pacman::updateDir(
     }
 }
 
-void pacman::updateSquare(
-    std::vector<std::vector<std::shared_ptr<square>>> vecBoard,
-    std::vector<std::shared_ptr<ghost>> vecGhost, fruit *Fruit) {
+void pacman::updateSquare(gridView vecBoard, ghostPack &Ghosts,
+                          fruit *Fruit) {
 
-    if (_xBoard > 20 || _yBoard >= 26) {
+    if (_xBoard >= vecBoard.getWidth() || _yBoard >= vecBoard.getHeight() - 1) {
         std::cerr << "Pacman out of the board in updateSquare" << std::endl;
         exit(EXIT_FAILURE);
     }
 
     // update item
-    if (vecBoard[_xBoard][_yBoard]->getItem() == _DOT) {
+    if (vecBoard.at(_xBoard, _yBoard).getItem() == _DOT) {
 
         if (_lastDir == LEFT || _lastDir == RIGHT) {
             if (abs(_xPixel % SCALE_PIXEL - PACMAN_CENTER_X) !=
@@ -208,15 +225,17 @@ void pacman::updateSquare(
         } else
             return;
 
-        _score = _score + vecBoard[_xBoard][_yBoard]->getScore();
+        _score = _score + vecBoard.at(_xBoard, _yBoard).getScore();
         _dotCounter++;
         _dotCounterLevel++;
-        vecBoard[_xBoard][_yBoard]->setItem(_EMPTY);
-        vecBoard[_xBoard][_yBoard]->setScore(0);
+        vecBoard.at(_xBoard, _yBoard).setItem(_EMPTY);
+        vecBoard.at(_xBoard, _yBoard).setScore(0);
+        if (vecBoard.getPellets() != nullptr)
+            vecBoard.getPellets()->remove(_xBoard, _yBoard);
 
-        noEatenDotTimer1 = std::chrono::steady_clock::now();
+        noEatenDotTimer1 = _clock->now();
 
-    } else if (vecBoard[_xBoard][_yBoard]->getItem() == _POWERUP) {
+    } else if (vecBoard.at(_xBoard, _yBoard).getItem() == _POWERUP) {
 
         if (_lastDir == LEFT || _lastDir == RIGHT) {
             if (abs(_xPixel % SCALE_PIXEL - PACMAN_CENTER_X) !=
@@ -231,22 +250,22 @@ void pacman::updateSquare(
         } else
             return;
 
-        _score = _score + vecBoard[_xBoard][_yBoard]->getScore();
-        vecBoard[_xBoard][_yBoard]->setItem(_EMPTY);
-        vecBoard[_xBoard][_yBoard]->setScore(0);
+        _score = _score + vecBoard.at(_xBoard, _yBoard).getScore();
+        vecBoard.at(_xBoard, _yBoard).setItem(_EMPTY);
+        vecBoard.at(_xBoard, _yBoard).setScore(0);
+        if (vecBoard.getPellets() != nullptr)
+            vecBoard.getPellets()->remove(_xBoard, _yBoard);
 
         _powerup = true;
         _ghostEatenScore = 0;
 
-        for (auto Ghost : vecGhost) {
-            if (Ghost->isInHouse() == false)
-                Ghost->setFrightened(true);
-        }
+        Ghosts.setFrightened(true);
 
-        powerupTimer1 = std::chrono::steady_clock::now();
+        powerupTimer1 = _clock->now();
 
-    } else if (_xBoard == FRUIT_X && _yBoard == FRUIT_Y &&
-               vecBoard[_xBoard][_yBoard]->getItem() == _FRUIT) {
+    } else if (_xBoard == size_t(_level->getFruit().x) &&
+               _yBoard == size_t(_level->getFruit().y) &&
+               vecBoard.at(_xBoard, _yBoard).getItem() == _FRUIT) {
 
         if (_lastDir == LEFT || _lastDir == RIGHT) {
             if (abs(_xPixel % 32 - PACMAN_CENTER_X) != FRUIT_PACMAN_CONTACT) {
@@ -259,9 +278,9 @@ void pacman::updateSquare(
         } else
             return;
 
-        _score = _score + vecBoard[_xBoard][_yBoard]->getScore();
-        _fruitEatenScore = vecBoard[_xBoard][_yBoard]->getScore();
-        fruitEatenTimer1 = std::chrono::steady_clock::now();
+        _score = _score + vecBoard.at(_xBoard, _yBoard).getScore();
+        _fruitEatenScore = vecBoard.at(_xBoard, _yBoard).getScore();
+        fruitEatenTimer1 = _clock->now();
         Fruit->eatFruit(vecBoard);
         _fruitEaten++;
         _eatenFruit.push_back(Fruit->getFruit());
@@ -269,45 +288,41 @@ void pacman::updateSquare(
 
     if (_powerup) {
 
-        time_t powerupTimer2 = std::chrono::steady_clock::now();
-        std::chrono::duration<double> elapsedTime =
-            powerupTimer2 - powerupTimer1;
-
-        if (elapsedTime.count() > POWERUP_MODE) {
+        if (_clock->getElapsed(powerupTimer1) > POWERUP_MODE) {
 
             _powerup = false;
-            for (auto Ghost : vecGhost) {
-                if (Ghost->isInHouse() == false)
-                    Ghost->setFrightened(false);
-            }
+            Ghosts.setFrightened(false);
         }
     }
 }
 
-time_t pacman::getPowerupTimer() { return powerupTimer1; }
+tick_t pacman::getPowerupTimer() { return powerupTimer1; }
 
 bool pacman::isPowerup() { return _powerup; }
 
 size_t pacman::getScore() { return _score; }
 
-bool pacman::ghostCollision(std::vector<std::shared_ptr<ghost>> vecGhost) {
+bool pacman::ghostCollision(ghostPack &Ghosts) {
 
-    for (auto Ghost : vecGhost) {
+    const std::vector<uint8_t> &contact =
+        Ghosts.findContact(_xPixel, _yPixel, GHOST_PACMAN_CONTACT);
 
-        if (abs(_xPixel - Ghost->getPos().first) < GHOST_PACMAN_CONTACT &&
-            abs(_yPixel - Ghost->getPos().second) < GHOST_PACMAN_CONTACT) {
+    for (size_t i = 0; i < Ghosts.size(); i++) {
 
-            if (Ghost->isReturnHouse() == false &&
-                Ghost->isFrightened() == true) {
+        if (contact[i]) {
 
-                Ghost->setReturnHouse();
+            ghost &Ghost = Ghosts[i];
+            if (Ghost.isReturnHouse() == false &&
+                Ghost.isFrightened() == true) {
+
+                Ghosts.setReturnHouse(i);
 
                 // multiply the ghost score by 2 each time a ghost is eaten on
                 // the same powerup
                 _ghostEatenScore++;
                 _score += (GHOST_SCORE * _ghostEatenScore);
                 _ghostEaten++;
-                _ghostEatenColor = Ghost->getGhost();
+                _ghostEatenColor = Ghost.getGhost();
 
                 // all ghost eaten for each powerup
                 if (_ghostEaten == 16)
@@ -315,8 +330,8 @@ bool pacman::ghostCollision(std::vector<std::shared_ptr<ghost>> vecGhost) {
 
                 return false;
 
-            } else if (Ghost->isReturnHouse() == false &&
-                       Ghost->isFrightened() == false)
+            } else if (Ghost.isReturnHouse() == false &&
+                       Ghost.isFrightened() == false)
                 return true;
         }
     }
@@ -335,13 +350,11 @@ size_t pacman::getGhostEatenScore() {
         return _ghostEatenScore * GHOST_SCORE;
 }
 
-std::vector<typeFruit> pacman::getEatenFruit() { return _eatenFruit; }
+const std::vector<typeFruit> &pacman::getEatenFruit() { return _eatenFruit; }
 
 short pacman::getFruitEaten() { return _fruitEaten; }
 
-time_t pacman::getfruitEatenTimer() { return fruitEatenTimer1; }
-
-void pacman::setFruitEatenScore(short score) { _fruitEatenScore = score; }
+tick_t pacman::getfruitEatenTimer() { return fruitEatenTimer1; }
 
 short pacman::getFruitEatenScore() { return _fruitEatenScore; }
 
@@ -360,4 +373,80 @@ void pacman::looseLife() { _remainingLife--; }
 
 dir pacman::getOldDir() { return _oldDir; }
 
-time_t pacman::getNoEatenDotTimer() { return noEatenDotTimer1; }
+tick_t pacman::getNoEatenDotTimer() { return noEatenDotTimer1; }
+
+bool pacman::save(PacmanState &state) const {
+
+    if (_eatenFruit.size() > SNAPSHOT_MAX_FRUITS)
+        return false;
+
+    state = PacmanState();
+    state.xBoard = _xBoard;
+    state.yBoard = _yBoard;
+    state.xPixel = _xPixel;
+    state.yPixel = _yPixel;
+    state.score = _score;
+    state.dotCounter = _dotCounter;
+    state.dotCounterLevel = _dotCounterLevel;
+    state.powerupTimer = powerupTimer1;
+    state.fruitEatenTimer = fruitEatenTimer1;
+    state.noEatenDotTimer = noEatenDotTimer1;
+    state.ghostEaten = _ghostEaten;
+    state.ghostEatenScore = _ghostEatenScore;
+    state.fruitEaten = _fruitEaten;
+    state.fruitEatenScore = _fruitEatenScore;
+    state.remainingLife = _remainingLife;
+    state.lastDir = _lastDir;
+    state.oldDir = _oldDir;
+    state.powerup = _powerup;
+    state.ghostEatenColor = _ghostEatenColor;
+    state.nbEatenFruits = _eatenFruit.size();
+    for (size_t i = 0; i < _eatenFruit.size(); i++)
+        state.eatenFruit[i] = _eatenFruit[i];
+    return true;
+}
+
+void pacman::restore(const PacmanState &state) {
+
+    _xBoard = state.xBoard;
+    _yBoard = state.yBoard;
+    _xPixel = state.xPixel;
+    _yPixel = state.yPixel;
+    _score = state.score;
+    _dotCounter = state.dotCounter;
+    _dotCounterLevel = state.dotCounterLevel;
+    powerupTimer1 = state.powerupTimer;
+    fruitEatenTimer1 = state.fruitEatenTimer;
+    noEatenDotTimer1 = state.noEatenDotTimer;
+    _ghostEaten = state.ghostEaten;
+    _ghostEatenScore = state.ghostEatenScore;
+    _fruitEaten = state.fruitEaten;
+    _fruitEatenScore = state.fruitEatenScore;
+    _remainingLife = state.remainingLife;
+    _lastDir = dir(state.lastDir);
+    _oldDir = dir(state.oldDir);
+    _powerup = state.powerup;
+    _ghostEatenColor = color(state.ghostEatenColor);
+    _eatenFruit.resize(state.nbEatenFruits);
+    for (size_t i = 0; i < _eatenFruit.size(); i++)
+        _eatenFruit[i] = typeFruit(state.eatenFruit[i]);
+}
+
+uint64_t pacman::getHash() const {
+    return zobristHasher(ZOBRIST_PACMAN)
+        .add(_xPixel)
+        .add(_yPixel)
+        .add(_xBoard | uint64_t(_yBoard) << 32)
+        .add(_lastDir | _oldDir << 8 | _powerup << 16 | _ghostEatenColor << 24 |
+             uint64_t(uint16_t(_remainingLife)) << 32)
+        .add(_score)
+        .add(_dotCounter | uint64_t(_dotCounterLevel) << 32)
+        .add(uint16_t(_ghostEaten) | uint16_t(_ghostEatenScore) << 16 |
+             uint64_t(uint16_t(_fruitEaten)) << 32 |
+             uint64_t(uint16_t(_fruitEatenScore)) << 48)
+        .add(powerupTimer1)
+        .add(fruitEatenTimer1)
+        .add(noEatenDotTimer1)
+        .add(_eatenFruit.size())
+        .get();
+}
@@ -0,0 +1,292 @@
+#include "pacman_env.h"
+#include "simulation.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#define ENV_GAMES_PER_THREAD 32 // fewer games are not worth waking a thread
+
+static_assert(PACMAN_ENV_LEFT == LEFT && PACMAN_ENV_RIGHT == RIGHT &&
+                  PACMAN_ENV_UP == UP && PACMAN_ENV_DOWN == DOWN &&
+                  PACMAN_ENV_NOOP == NONE,
+              "the actions are the directions of the game");
+
+/**
+ * @brief The games and the threads which play them. Each thread plays the
+ * same range of games at each step, woken by a new generation of the work.
+ */
+struct pacman_env {
+    size_t nbEnvs;
+    uint64_t seed;
+    size_t width, height, nbPlanes, obsSize;
+    // walls plane, the same for all the games
+    std::vector<uint8_t> walls;
+    std::vector<std::unique_ptr<simulation>> games;
+    // games played by each environment, for their seeds
+    std::vector<uint64_t> episodes;
+
+    // work of the current step, read by all the threads
+    const int32_t *actions;
+    uint8_t *obs;
+    float *rewards;
+    uint8_t *dones;
+    bool reset;
+
+    // the calling thread plays the first range of games
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake, finished;
+    uint64_t generation;
+    size_t running;
+    bool stop;
+};
+
+/**
+ * @brief Write the observation of a game.
+ *
+ * @param env
+ * @param Sim
+ * @param obs
+ */
+static void writeObservation(pacman_env *env, simulation &Sim, uint8_t *obs) {
+
+    size_t width = env->width, height = env->height, cells = width * height;
+    memcpy(obs + PACMAN_ENV_PLANE_WALLS * cells, env->walls.data(), cells);
+
+    // items, read in the lines of the bitboard
+    const bitboard &bits = Sim.getBoard().getBits();
+    uint8_t *dots = obs + PACMAN_ENV_PLANE_DOTS * cells;
+    uint8_t *powerups = obs + PACMAN_ENV_PLANE_POWERUPS * cells;
+    for (size_t y = 0; y < height; y++) {
+        const uint64_t *dotRow = bits.getRow(LAYER_DOT, y);
+        const uint64_t *powerupRow = bits.getRow(LAYER_POWERUP, y);
+        for (size_t x = 0; x < width; x++) {
+            dots[y * width + x] = (dotRow[x / 64] >> (x % 64)) & 1;
+            powerups[y * width + x] = (powerupRow[x / 64] >> (x % 64)) & 1;
+        }
+    }
+
+    // actors, the ones in a tunnel may be outside the board
+    uint8_t *actors = obs + PACMAN_ENV_PLANE_PACMAN * cells;
+    memset(actors, 0, (env->nbPlanes - PACMAN_ENV_PLANE_PACMAN) * cells);
+    size_t x = Sim.getPacman().getPos().first / SCALE_PIXEL;
+    size_t y = Sim.getPacman().getPos().second / SCALE_PIXEL;
+    if (x < width && y < height)
+        actors[y * width + x] = 1;
+    uint8_t *ghosts = obs + PACMAN_ENV_PLANE_GHOSTS * cells;
+    for (auto &Ghost : Sim.getGhosts()) {
+        x = Ghost.getPos().first / SCALE_PIXEL;
+        y = Ghost.getPos().second / SCALE_PIXEL;
+        if (x < width && y < height)
+            ghosts[y * width + x] = Ghost.isReturnHouse()
+                                        ? PACMAN_ENV_GHOST_EYES
+                                    : Ghost.isFrightened()
+                                        ? PACMAN_ENV_GHOST_FRIGHTENED
+                                        : PACMAN_ENV_GHOST_DANGER;
+        ghosts += cells;
+    }
+}
+
+/**
+ * @brief Start the next game of an environment.
+ *
+ * @param env
+ * @param i
+ */
+static void startGame(pacman_env *env, size_t i) {
+
+    simulation &Sim = *env->games[i];
+    Sim.setSeed(env->seed + i + env->episodes[i]++ * env->nbEnvs);
+    Sim.newGame();
+    Sim.startLife();
+}
+
+/**
+ * @brief Play the work of the current step on a range of games.
+ *
+ * @param env
+ * @param first
+ * @param last excluded
+ */
+static void playGames(pacman_env *env, size_t first, size_t last) {
+
+    for (size_t i = first; i < last; i++) {
+        simulation &Sim = *env->games[i];
+        uint8_t *obs = env->obs + i * env->obsSize;
+        if (env->reset) {
+            startGame(env, i);
+            writeObservation(env, Sim, obs);
+            continue;
+        }
+
+        int32_t action = env->actions[i];
+        dir input = action >= LEFT && action <= NONE ? dir(action) : NONE;
+        size_t score = Sim.getPacman().getScore();
+        stepResult result = Sim.step(input);
+        env->rewards[i] = float(Sim.getPacman().getScore() - score);
+        env->dones[i] = result == STEP_GAME_OVER;
+
+        // the lives follow each other, a new game starts after the last one
+        if (result == STEP_DEATH || result == STEP_LEVEL_CLEARED)
+            Sim.startLife();
+        else if (result == STEP_GAME_OVER)
+            startGame(env, i);
+        writeObservation(env, Sim, obs);
+    }
+}
+
+/**
+ * @brief Get the first game of the range of a thread.
+ *
+ * @param env
+ * @param thread 0 for the calling thread
+ * @return size_t
+ */
+static size_t firstGame(pacman_env *env, size_t thread) {
+    return thread * env->nbEnvs / (env->workers.size() + 1);
+}
+
+/**
+ * @brief Loop of a thread: play its range of games at each new generation.
+ *
+ * @param env
+ * @param thread
+ */
+static void runWorker(pacman_env *env, size_t thread) {
+
+    uint64_t generation = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(env->mutex);
+            env->wake.wait(lock, [&]() {
+                return env->stop || env->generation != generation;
+            });
+            if (env->stop)
+                return;
+            generation = env->generation;
+        }
+        playGames(env, firstGame(env, thread), firstGame(env, thread + 1));
+        std::lock_guard<std::mutex> lock(env->mutex);
+        if (--env->running == 0)
+            env->finished.notify_one();
+    }
+}
+
+/**
+ * @brief Play the work of the current step on all the games.
+ *
+ * @param env
+ */
+static void playAll(pacman_env *env) {
+
+    {
+        std::lock_guard<std::mutex> lock(env->mutex);
+        env->generation++;
+        env->running = env->workers.size();
+    }
+    env->wake.notify_all();
+    playGames(env, 0, firstGame(env, 1));
+    std::unique_lock<std::mutex> lock(env->mutex);
+    env->finished.wait(lock, [&]() { return env->running == 0; });
+}
+
+pacman_env *pacman_env_create(size_t n_envs, uint64_t seed) {
+    return pacman_env_create_level(LEVEL_FILE, n_envs, seed, 0);
+}
+
+pacman_env *pacman_env_create_level(const char *levelName, size_t n_envs,
+                                    uint64_t seed, size_t n_threads) {
+
+    if (levelName == nullptr || n_envs == 0)
+        return nullptr;
+
+    // no exception crosses the C API
+    pacman_env *env = nullptr;
+    try {
+        // the simulation leaves on a missing level, it is checked first
+        level Level;
+        if (!Level.load(levelName))
+            return nullptr;
+
+        env = new pacman_env();
+        env->nbEnvs = n_envs;
+        env->seed = seed;
+        env->width = Level.getWidth();
+        env->height = Level.getHeight();
+        env->nbPlanes = PACMAN_ENV_PLANE_GHOSTS + NB_GHOSTS;
+        env->obsSize = env->nbPlanes * env->width * env->height;
+        for (size_t y = 0; y < env->height; y++) {
+            for (size_t x = 0; x < env->width; x++)
+                env->walls.push_back(Level.getState(x, y) != HALL);
+        }
+
+        // the games share the path tables of the first one, they can be
+        // played before the first reset, which starts them again with the
+        // same seeds
+        for (size_t i = 0; i < n_envs; i++) {
+            env->games.push_back(std::make_unique<simulation>(seed + i));
+            env->games.back()->load(
+                levelName, env->games[0]->getBoard().getPathTables());
+            env->games.back()->newGame();
+            env->games.back()->startLife();
+        }
+        env->episodes.assign(n_envs, 0);
+        env->generation = 0;
+        env->running = 0;
+        env->stop = false;
+
+        if (n_threads == 0)
+            n_threads = std::thread::hardware_concurrency();
+        n_threads = std::min(n_threads, (n_envs + ENV_GAMES_PER_THREAD - 1) /
+                                            ENV_GAMES_PER_THREAD);
+        for (size_t i = 1; i < n_threads; i++)
+            env->workers.emplace_back(runWorker, env, i);
+    } catch (...) {
+        pacman_env_destroy(env);
+        return nullptr;
+    }
+    return env;
+}
+
+void pacman_env_destroy(pacman_env *env) {
+
+    if (env == nullptr)
+        return;
+    {
+        std::lock_guard<std::mutex> lock(env->mutex);
+        env->stop = true;
+    }
+    env->wake.notify_all();
+    for (auto &worker : env->workers)
+        worker.join();
+    delete env;
+}
+
+size_t pacman_env_num_envs(const pacman_env *env) { return env->nbEnvs; }
+
+void pacman_env_obs_shape(const pacman_env *env, size_t *planes,
+                          size_t *height, size_t *width) {
+    *planes = env->nbPlanes;
+    *height = env->height;
+    *width = env->width;
+}
+
+void pacman_env_reset(pacman_env *env, uint8_t *obs) {
+
+    env->obs = obs;
+    env->reset = true;
+    playAll(env);
+}
+
+void pacman_env_step(pacman_env *env, const int32_t *actions, uint8_t *obs,
+                     float *rewards, uint8_t *dones) {
+
+    env->actions = actions;
+    env->obs = obs;
+    env->rewards = rewards;
+    env->dones = dones;
+    env->reset = false;
+    playAll(env);
+}
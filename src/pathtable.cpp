@@ -0,0 +1,249 @@
+#include "pathtable.h"
+
+// order in which the neighbors are visited, same as findShortestPath
+static const dir neighborDir[4] = {LEFT, UP, DOWN, RIGHT};
+
+static dir opposite(dir d) {
+    switch (d) {
+    case LEFT:
+        return RIGHT;
+    case RIGHT:
+        return LEFT;
+    case UP:
+        return DOWN;
+    case DOWN:
+        return UP;
+    case NONE:
+        break;
+    }
+    return NONE;
+}
+
+pathTable::pathTable() {
+    _width = 0;
+    _height = 0;
+    _nbCells = 0;
+    _checksum = 0;
+}
+
+pathTable::~pathTable() {}
+
+uint64_t pathTable::checksum(gridView vecBoard) {
+    // FNV-1a on the dimensions and the states of the squares
+    uint64_t hash = 14695981039346656037ULL;
+    auto add = [&hash](uint64_t value) {
+        hash ^= value;
+        hash *= 1099511628211ULL;
+    };
+    add(vecBoard.getWidth());
+    add(vecBoard.getHeight());
+    for (size_t y = 0; y < vecBoard.getHeight(); y++) {
+        for (size_t x = 0; x < vecBoard.getWidth(); x++)
+            add(vecBoard.at(x, y).getState());
+    }
+    return hash;
+}
+
+void pathTable::indexCells(gridView vecBoard) {
+
+    // give an id to each square which is not a wall
+    _cell.assign(_width * _height, -1);
+    _coord.clear();
+    for (size_t y = 0; y < _height; y++) {
+        for (size_t x = 0; x < _width; x++) {
+            if (vecBoard.at(x, y).getState() != WALL) {
+                _cell[y * _width + x] = _coord.size();
+                _coord.push_back({int(x), int(y)});
+            }
+        }
+    }
+    _nbCells = _coord.size();
+}
+
+int pathTable::getCell(size_t x, size_t y) const {
+    if (x >= _width || y >= _height)
+        return -1;
+    return _cell[y * _width + x];
+}
+
+int pathTable::getNeighbor(size_t x, size_t y, dir d) const {
+    switch (d) {
+    case LEFT:
+        // tunnel
+        if (x == 0)
+            return getCell(_width - 1, y);
+        return getCell(x - 1, y);
+    case RIGHT:
+        // tunnel
+        if (x == _width - 1)
+            return getCell(0, y);
+        return getCell(x + 1, y);
+    case UP:
+        return y == 0 ? -1 : getCell(x, y - 1);
+    case DOWN:
+        return getCell(x, y + 1);
+    case NONE:
+        break;
+    }
+    return -1;
+}
+
+void pathTable::build(gridView vecBoard) {
+
+    _width = vecBoard.getWidth();
+    _height = vecBoard.getHeight();
+    _checksum = checksum(vecBoard);
+
+    indexCells(vecBoard);
+
+    _distance.assign(_nbCells * _nbCells, UNREACHABLE);
+    _nextDir.assign(_nbCells * _nbCells, NONE);
+
+    // BFS from each cell, the first move is inherited from the parent
+    std::vector<int> queue(_nbCells);
+    for (size_t start = 0; start < _nbCells; start++) {
+
+        uint16_t *distance = &_distance[start * _nbCells];
+        uint8_t *nextDir = &_nextDir[start * _nbCells];
+        size_t head = 0, tail = 0;
+
+        distance[start] = 0;
+        queue[tail++] = start;
+
+        while (head < tail) {
+            int current = queue[head++];
+            Coordinate coord = _coord[current];
+
+            for (dir d : neighborDir) {
+                int neighbor = getNeighbor(coord.x, coord.y, d);
+                if (neighbor == -1 || distance[neighbor] != UNREACHABLE)
+                    continue;
+
+                distance[neighbor] = distance[current] + 1;
+                if (size_t(current) == start)
+                    nextDir[neighbor] = d;
+                else
+                    nextDir[neighbor] = nextDir[current];
+                queue[tail++] = neighbor;
+            }
+        }
+    }
+}
+
+bool pathTable::load(const std::string &fileName, gridView vecBoard) {
+
+    std::ifstream file(fileName, std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    uint32_t header[5];
+    uint64_t fileChecksum;
+    file.read(reinterpret_cast<char *>(header), sizeof(header));
+    file.read(reinterpret_cast<char *>(&fileChecksum), sizeof(fileChecksum));
+    if (!file || header[0] != PATH_TABLE_MAGIC ||
+        header[1] != PATH_TABLE_VERSION ||
+        header[2] != vecBoard.getWidth() ||
+        header[3] != vecBoard.getHeight() ||
+        fileChecksum != checksum(vecBoard))
+        return false;
+
+    // the cell ids only depend on the board
+    _width = header[2];
+    _height = header[3];
+    _checksum = fileChecksum;
+    indexCells(vecBoard);
+    if (header[4] != _nbCells)
+        return false;
+
+    _distance.resize(_nbCells * _nbCells);
+    _nextDir.resize(_nbCells * _nbCells);
+    file.read(reinterpret_cast<char *>(_distance.data()),
+              _distance.size() * sizeof(uint16_t));
+    file.read(reinterpret_cast<char *>(_nextDir.data()), _nextDir.size());
+
+    if (!file) {
+        _nbCells = 0;
+        return false;
+    }
+    return true;
+}
+
+bool pathTable::save(const std::string &fileName) {
+
+    std::ofstream file(fileName, std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    uint32_t header[5] = {PATH_TABLE_MAGIC, PATH_TABLE_VERSION,
+                          uint32_t(_width), uint32_t(_height),
+                          uint32_t(_nbCells)};
+    file.write(reinterpret_cast<const char *>(header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(&_checksum), sizeof(_checksum));
+    file.write(reinterpret_cast<const char *>(_distance.data()),
+               _distance.size() * sizeof(uint16_t));
+    file.write(reinterpret_cast<const char *>(_nextDir.data()),
+               _nextDir.size());
+
+    return bool(file);
+}
+
+bool pathTable::isBuilt() const { return _nbCells != 0; }
+
+bool pathTable::matches(gridView vecBoard) const {
+    return isBuilt() && _width == vecBoard.getWidth() &&
+           _height == vecBoard.getHeight() && _checksum == checksum(vecBoard);
+}
+
+int pathTable::getDistance(size_t xStart, size_t yStart, size_t xEnd,
+                           size_t yEnd) const {
+
+    int start = getCell(xStart, yStart);
+    int end = getCell(xEnd, yEnd);
+    if (start == -1 || end == -1)
+        return -1;
+
+    uint16_t distance = _distance[start * _nbCells + end];
+    return distance == UNREACHABLE ? -1 : distance;
+}
+
+dir pathTable::getNextDir(size_t xStart, size_t yStart, size_t xEnd,
+                          size_t yEnd) const {
+
+    int start = getCell(xStart, yStart);
+    int end = getCell(xEnd, yEnd);
+    if (start == -1 || end == -1)
+        return NONE;
+
+    return dir(_nextDir[start * _nbCells + end]);
+}
+
+dir pathTable::getNextDir(size_t xStart, size_t yStart, size_t xEnd,
+                          size_t yEnd, dir lastDir) const {
+
+    dir nextDir = getNextDir(xStart, yStart, xEnd, yEnd);
+    dir aboutTurn = opposite(lastDir);
+    if (nextDir != aboutTurn || nextDir == NONE)
+        return nextDir;
+
+    // the shortest path goes back, take the shortest one among the other
+    // neighbors
+    int end = getCell(xEnd, yEnd);
+    uint16_t bestDistance = UNREACHABLE;
+    nextDir = NONE;
+    for (dir d : neighborDir) {
+        if (d == aboutTurn)
+            continue;
+
+        int neighbor = getNeighbor(xStart, yStart, d);
+        if (neighbor == -1)
+            continue;
+
+        uint16_t distance = _distance[neighbor * _nbCells + end];
+        if (distance < bestDistance) {
+            bestDistance = distance;
+            nextDir = d;
+        }
+    }
+
+    return nextDir;
+}
@@ -0,0 +1,78 @@
+#include "pellets.h"
+
+pelletTracker::pelletTracker() {
+    _width = 0;
+    _height = 0;
+    _hash = 0;
+}
+
+pelletTracker::~pelletTracker() {}
+
+void pelletTracker::build(gridView vecBoard) {
+
+    _width = vecBoard.getWidth();
+    _height = vecBoard.getHeight();
+    // the items are put in the bitboard with their slot below
+    _bits.build(vecBoard);
+    _bits.clear(LAYER_DOT);
+    _bits.clear(LAYER_POWERUP);
+    _slot.assign(_width * _height, -1);
+    _vecDot.clear();
+    _vecPowerup.clear();
+    _hash = 0;
+
+    for (size_t y = 0; y < _height; y++) {
+        for (size_t x = 0; x < _width; x++)
+            add(x, y, typeItem(vecBoard.at(x, y).getItem()));
+    }
+}
+
+void pelletTracker::add(size_t x, size_t y, typeItem item) {
+
+    std::vector<Coordinate> *vecItem = nullptr;
+    layer l = LAYER_DOT;
+    zobristPiece piece = ZOBRIST_DOT;
+    if (item == _DOT)
+        vecItem = &_vecDot;
+    else if (item == _POWERUP) {
+        vecItem = &_vecPowerup;
+        l = LAYER_POWERUP;
+        piece = ZOBRIST_POWERUP;
+    }
+    if (vecItem == nullptr || isPellet(x, y))
+        return;
+
+    _bits.set(l, x, y);
+    _hash ^= zobristKey(piece, y * _width + x);
+    _slot[y * _width + x] = vecItem->size();
+    vecItem->push_back({int(x), int(y)});
+}
+
+void pelletTracker::remove(size_t x, size_t y) {
+
+    if (!isPellet(x, y))
+        return;
+
+    size_t cell = y * _width + x;
+    int slot = _slot[cell];
+
+    // find the list of the item
+    std::vector<Coordinate> *vecItem = &_vecPowerup;
+    layer l = LAYER_POWERUP;
+    zobristPiece piece = ZOBRIST_POWERUP;
+    if (_bits.test(LAYER_DOT, x, y)) {
+        vecItem = &_vecDot;
+        l = LAYER_DOT;
+        piece = ZOBRIST_DOT;
+    }
+
+    // move the last item in the slot
+    Coordinate last = vecItem->back();
+    (*vecItem)[slot] = last;
+    _slot[last.y * _width + last.x] = slot;
+    vecItem->pop_back();
+
+    _slot[cell] = -1;
+    _bits.reset(l, x, y);
+    _hash ^= zobristKey(piece, cell);
+}
@@ -0,0 +1,232 @@
+#include "replay.h"
+#include <cstddef>
+#include <cstring>
+
+#define DIR_BITS 3 // bits of the direction in a change
+// size of the header of the first version, without the hashes
+#define REPLAY_V1_HEADER_SIZE offsetof(ReplayHeader, hash)
+
+// given by the Makefile
+#ifndef BUILD_COMMIT
+#define BUILD_COMMIT "unknown"
+#endif
+
+/**
+ * @brief Write an unsigned integer in 7 bits groups, the high bit of a byte
+ * is set when another byte follows.
+ *
+ * @param stream
+ * @param value
+ */
+static void writeVarint(std::vector<uint8_t> &stream, uint64_t value) {
+    while (value >= 0x80) {
+        stream.push_back(uint8_t(value) | 0x80);
+        value >>= 7;
+    }
+    stream.push_back(uint8_t(value));
+}
+
+/**
+ * @brief Read an unsigned integer written by writeVarint.
+ *
+ * @param stream
+ * @param pos the position in the stream, moved after the integer
+ * @param value
+ * @return true
+ * @return false if the stream ends before the integer
+ */
+static bool readVarint(const std::vector<uint8_t> &stream, size_t &pos,
+                       uint64_t &value) {
+    value = 0;
+    for (int shift = 0; pos < stream.size() && shift < 64; shift += 7) {
+        uint8_t byte = stream[pos++];
+        value |= uint64_t(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
+replay::replay() {
+    memset(&_header, 0, sizeof(_header));
+    _lastInput = NONE;
+    _lastChange = 0;
+}
+
+void replay::start(simulation &Sim, const std::string &levelName) {
+
+    memset(&_header, 0, sizeof(_header));
+    _header.magic = REPLAY_MAGIC;
+    _header.version = REPLAY_VERSION;
+    _header.seed = Sim.getSeed();
+    _header.levelHash = Sim.getBoard().getLevel().getHash();
+    _header.nbGhosts = Sim.getNbGhosts();
+    _header.level = 1;
+    _levelName = levelName;
+    _build = currentBuild();
+    _stream.clear();
+    _checks.clear();
+    _lastInput = NONE;
+    _lastChange = 0;
+}
+
+void replay::record(dir input, simulation &Sim) {
+
+    if (_header.steps % REPLAY_CHECK_STEPS == 0)
+        _checks.push_back(Sim.getHash());
+
+    if (input != _lastInput) {
+        writeVarint(_stream,
+                    (_header.steps - _lastChange) << DIR_BITS | input);
+        _header.nbChanges++;
+        _lastInput = input;
+        _lastChange = _header.steps;
+    }
+    _header.steps++;
+}
+
+const char *replay::currentBuild() { return BUILD_COMMIT; }
+
+void replay::finish(simulation &Sim) {
+    _header.score = Sim.getPacman().getScore();
+    _header.level = Sim.getLevel();
+    _header.hash = Sim.getHash();
+}
+
+bool replay::save(const std::string &fileName) const {
+
+    std::ofstream file(fileName, std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    ReplayHeader header = _header;
+    header.levelNameLength = _levelName.size();
+    header.buildLength = _build.size();
+    header.streamLength = _stream.size();
+    header.version = REPLAY_VERSION;
+    header.nbChecks = _checks.size();
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(_levelName.data(), _levelName.size());
+    file.write(_build.data(), _build.size());
+    file.write(reinterpret_cast<const char *>(_stream.data()),
+               _stream.size());
+    file.write(reinterpret_cast<const char *>(_checks.data()),
+               _checks.size() * sizeof(uint64_t));
+
+    return bool(file);
+}
+
+bool replay::load(const std::string &fileName) {
+
+    std::ifstream file(fileName, std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    // the replays of the first version have no hash
+    ReplayHeader header;
+    memset(&header, 0, sizeof(header));
+    if (!file.read(reinterpret_cast<char *>(&header), REPLAY_V1_HEADER_SIZE) ||
+        header.magic != REPLAY_MAGIC || header.version < 1 ||
+        header.version > REPLAY_VERSION)
+        return false;
+    if (header.version > 1 &&
+        !file.read(reinterpret_cast<char *>(&header) + REPLAY_V1_HEADER_SIZE,
+                   sizeof(header) - REPLAY_V1_HEADER_SIZE))
+        return false;
+
+    // the sizes of the header are checked against the size of the file
+    // before anything is allocated, each change takes at least one byte
+    std::streamoff headerSize = file.tellg();
+    file.seekg(0, std::ios::end);
+    uint64_t fileSize = uint64_t(file.tellg());
+    file.seekg(headerSize);
+    if (!file || uint64_t(headerSize) + header.levelNameLength +
+                         header.buildLength + header.streamLength +
+                         uint64_t(header.nbChecks) * sizeof(uint64_t) >
+                     fileSize ||
+        header.nbChanges > header.streamLength ||
+        header.nbGhosts > REPLAY_MAX_GHOSTS)
+        return false;
+
+    std::string levelName(header.levelNameLength, '\0');
+    std::string build(header.buildLength, '\0');
+    std::vector<uint8_t> stream(header.streamLength);
+    std::vector<uint64_t> checks(header.nbChecks);
+    file.read(&levelName[0], levelName.size());
+    file.read(&build[0], build.size());
+    file.read(reinterpret_cast<char *>(stream.data()), stream.size());
+    file.read(reinterpret_cast<char *>(checks.data()),
+              checks.size() * sizeof(uint64_t));
+    if (!file)
+        return false;
+
+    // the changes are read once to check them
+    size_t pos = 0;
+    uint64_t change = 0, step = 0;
+    for (uint32_t i = 0; i < header.nbChanges; i++) {
+        if (!readVarint(stream, pos, change) ||
+            (change & ((1 << DIR_BITS) - 1)) > NONE)
+            return false;
+        step += change >> DIR_BITS;
+    }
+    if (pos != stream.size() || step > header.steps)
+        return false;
+
+    _header = header;
+    _levelName.swap(levelName);
+    _build.swap(build);
+    _stream.swap(stream);
+    _checks.swap(checks);
+    _lastInput = NONE;
+    _lastChange = 0;
+    return true;
+}
+
+ReplayResult replay::play(simulation &Sim) const {
+
+    ReplayResult result = {0, 1, 0, 0, REPLAY_NO_DIVERGENCE};
+    Sim.setSeed(_header.seed);
+    Sim.setNbGhosts(_header.nbGhosts);
+    Sim.newGame();
+    Sim.startLife();
+
+    // step of the next change of direction
+    size_t pos = 0;
+    uint64_t change = 0, nextChange = 0;
+    bool hasChange = readVarint(_stream, pos, change);
+    nextChange = change >> DIR_BITS;
+    dir input = NONE;
+
+    for (uint64_t step = 0; step < _header.steps; step++) {
+
+        // the game is compared with the recorded one until it differs
+        if (step % REPLAY_CHECK_STEPS == 0 &&
+            step / REPLAY_CHECK_STEPS < _checks.size() &&
+            result.divergence == REPLAY_NO_DIVERGENCE &&
+            Sim.getHash() != _checks[step / REPLAY_CHECK_STEPS])
+            result.divergence = step;
+
+        if (hasChange && step == nextChange) {
+            input = dir(change & ((1 << DIR_BITS) - 1));
+            hasChange = readVarint(_stream, pos, change);
+            nextChange += change >> DIR_BITS;
+        }
+
+        stepResult stepped = Sim.step(input);
+        if (stepped == STEP_DEATH || stepped == STEP_GAME_OVER)
+            result.deaths++;
+        if (stepped == STEP_GAME_OVER)
+            break;
+        if (stepped == STEP_DEATH || stepped == STEP_LEVEL_CLEARED)
+            Sim.startLife();
+    }
+
+    result.score = Sim.getPacman().getScore();
+    result.level = Sim.getLevel();
+    result.ticks = Sim.getClock().now();
+    // the end of the game is checked when the replay has hashes
+    if (_header.version > 1 && result.divergence == REPLAY_NO_DIVERGENCE &&
+        Sim.getHash() != _header.hash)
+        result.divergence = _header.steps;
+    return result;
+}
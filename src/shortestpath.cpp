@@ -1,43 +1,106 @@
 #include "shortestpath.h"
+#include "pellets.h"
+
+/**
+ * @brief Entry of the open set, ordered by f score and then by insertion order
+ * so that the first inserted node wins on equal f score.
+ */
+struct OpenNode {
+    int fScore;
+    size_t order;
+    size_t cell;
+};
+
+bool operator<(const OpenNode &a, const OpenNode &b) {
+    // std::push_heap builds a max heap, the lowest f score must be the greatest
+    if (a.fScore != b.fScore)
+        return a.fScore > b.fScore;
+    return a.order > b.order;
+}
 
-int findNode(std::set<std::shared_ptr<Node>> set, std::shared_ptr<Node> node) {
-    size_t i = 0;
-    for (auto it = set.begin(); it != set.end(); it++) {
-        if ((*it)->x == node->x && (*it)->y == node->y)
-            return i;
-        i++;
+/**
+ * @brief Buffers of the search indexed by cell id (y * width + x). They are
+ * kept between two queries, a node is only valid in a buffer if its stamp
+ * equals the stamp of the current query, so nothing is cleared nor allocated
+ * once the buffers have the size of the board.
+ */
+struct SearchBuffers {
+    std::vector<int> distance;
+    std::vector<size_t> parent;
+    std::vector<unsigned> openStamp;
+    std::vector<unsigned> closedStamp;
+    std::vector<OpenNode> openSet;
+    unsigned stamp = 0;
+};
+
+static thread_local SearchBuffers buffers;
+
+static bool isBlocked(gridView vecBoard, const BlockedSquares &blocked,
+                      size_t x, size_t y) {
+    if (vecBoard.at(x, y).getState() == WALL)
+        return true;
+
+    for (size_t i = 0; i < blocked.size; i++) {
+        if (size_t(blocked.squares[i].x) == x &&
+            size_t(blocked.squares[i].y) == y)
+            return true;
     }
-    return -1;
+    return false;
+}
+
+std::vector<Node> findShortestPath(gridView vecBoard, size_t xStart,
+                                   size_t yStart, size_t xEnd, size_t yEnd) {
+    return findShortestPath(vecBoard, BlockedSquares{0, {}}, xStart, yStart,
+                            xEnd, yEnd);
 }
 
-std::vector<std::shared_ptr<Node>>
-findShortestPath(std::vector<std::vector<std::shared_ptr<square>>> vecBoard,
-                 size_t xStart, size_t yStart, size_t xEnd, size_t yEnd) {
+std::vector<Node> findShortestPath(gridView vecBoard,
+                                   const BlockedSquares &blocked,
+                                   size_t xStart, size_t yStart, size_t xEnd,
+                                   size_t yEnd) {
 
-    if (vecBoard[xStart][yStart]->getState() == WALL)
+    if (isBlocked(vecBoard, blocked, xStart, yStart))
         return {};
 
-    if (vecBoard[xEnd][yEnd]->getState() == WALL)
+    if (isBlocked(vecBoard, blocked, xEnd, yEnd))
         return {};
 
     if (xStart == xEnd && yStart == yEnd)
         return {};
 
+    const size_t width = vecBoard.getWidth();
+    const size_t nbCells = width * vecBoard.getHeight();
+
     // define a lambda function for calculating the heuristic (Manhattan
     // distance)
-    auto heuristic = [](std::shared_ptr<Node> a, std::shared_ptr<Node> b) {
-        return std::abs((int)a->x - (int)b->x) +
-               std::abs((int)a->y - (int)b->y);
+    auto heuristic = [&](size_t cell) {
+        return std::abs((int)(cell % width) - (int)xEnd) +
+               std::abs((int)(cell / width) - (int)yEnd);
     };
 
-    // initialize the open and closed sets
-    std::set<std::shared_ptr<Node>> openSet;
-    std::set<std::shared_ptr<Node>> closedSet;
-    std::shared_ptr<Node> start =
-        std::make_shared<Node>(Node({xStart, yStart, 0, nullptr}));
-    std::shared_ptr<Node> end =
-        std::make_shared<Node>(Node({xEnd, yEnd, 0, nullptr}));
-    openSet.insert(start);
+    // initialize the buffers of the open and closed sets
+    if (buffers.distance.size() < nbCells) {
+        buffers.distance.resize(nbCells);
+        buffers.parent.resize(nbCells);
+        buffers.openStamp.assign(nbCells, 0);
+        buffers.closedStamp.assign(nbCells, 0);
+    }
+    if (++buffers.stamp == 0) {
+        std::fill(buffers.openStamp.begin(), buffers.openStamp.end(), 0);
+        std::fill(buffers.closedStamp.begin(), buffers.closedStamp.end(), 0);
+        buffers.stamp = 1;
+    }
+    const unsigned stamp = buffers.stamp;
+    std::vector<OpenNode> &openSet = buffers.openSet;
+    openSet.clear();
+
+    const size_t start = yStart * width + xStart;
+    const size_t end = yEnd * width + xEnd;
+    size_t order = 0;
+    buffers.distance[start] = 0;
+    buffers.parent[start] = start;
+    buffers.openStamp[start] = stamp;
+    openSet.push_back({heuristic(start), order++, start});
 
     // avoid infinite loop
     int maxDist = 0;
@@ -46,31 +109,31 @@ findShortestPath(std::vector<std::vector<std::shared_ptr<square>>> vecBoard,
     while (!openSet.empty()) {
 
         // get the node with the lowest f_score from the open set
-        auto current = *openSet.begin();
-        for (auto node : openSet) {
-            if (node->distance + heuristic(node, end) <
-                current->distance + heuristic(current, end))
-                current = node;
-        }
+        std::pop_heap(openSet.begin(), openSet.end());
+        const OpenNode current = openSet.back();
+        openSet.pop_back();
+
+        // skip the nodes already expanded or updated with a shorter distance
+        if (buffers.closedStamp[current.cell] == stamp ||
+            current.fScore !=
+                buffers.distance[current.cell] + heuristic(current.cell))
+            continue;
 
         // if the current node is the end node, it is the final path or if the
         // algorithm is stuck (bounded by CONVERGENCE)
-        if ((current->x == end->x && current->y == end->y) ||
-            maxDist > CONVERGENCE) {
-            std::vector<std::shared_ptr<Node>> path;
+        if (current.cell == end || maxDist > CONVERGENCE) {
+            std::vector<Node> path(buffers.distance[current.cell] + 1);
             // pull up all the parents of the current node
-            while (current) {
-                path.push_back(current);
-                current = current->parent;
+            size_t cell = current.cell;
+            for (size_t i = path.size(); i-- > 0;) {
+                path[i] = {cell % width, cell / width, buffers.distance[cell]};
+                cell = buffers.parent[cell];
             }
-            std::reverse(path.begin(), path.end());
             return path;
         }
 
-        // remove the current node from the open set and add it to the closed
-        // set
-        openSet.erase(current);
-        closedSet.insert(current);
+        // add the current node to the closed set
+        buffers.closedStamp[current.cell] = stamp;
 
         // check the neighbors of the current node
         for (int i = -1; i <= 1; i++) {
@@ -81,37 +144,31 @@ findShortestPath(std::vector<std::vector<std::shared_ptr<square>>> vecBoard,
                     continue;
 
                 // check all the neighbors
-                size_t x = current->x + i;
-                size_t y = current->y + j;
+                size_t x = current.cell % width + i;
+                size_t y = current.cell / width + j;
 
-                if (x > 20 || y >= 26)
+                if (!vecBoard.isInside(x, y))
                     continue;
-                if (vecBoard[x][y]->getState() == WALL)
+                if (isBlocked(vecBoard, blocked, x, y))
                     continue;
 
-                // create the neighbor node
-                std::shared_ptr<Node> neighbor = std::make_shared<Node>(
-                    Node{x, y, current->distance + 1, current});
-
                 // if the neighbor is already in the closed set, skip it
-                int index = findNode(closedSet, neighbor);
-                if (index == -1) {
-                    index = findNode(openSet, neighbor);
-                    if (index != -1) {
-                        // update the neighbor's distance if a shorter path
-                        // was found
-                        auto it = openSet.begin();
-                        std::advance(it, index);
-                        auto element = *it;
-                        if ((*it)->distance > neighbor->distance) {
-                            openSet.erase(it);
-                            openSet.insert(neighbor);
-                            maxDist = neighbor->distance;
-                        }
-                    } else {
-                        openSet.insert(neighbor);
-                        maxDist = neighbor->distance;
-                    }
+                size_t neighbor = y * width + x;
+                if (buffers.closedStamp[neighbor] == stamp)
+                    continue;
+
+                // insert the neighbor or update its distance if a shorter
+                // path was found
+                int distance = buffers.distance[current.cell] + 1;
+                if (buffers.openStamp[neighbor] != stamp ||
+                    buffers.distance[neighbor] > distance) {
+                    buffers.openStamp[neighbor] = stamp;
+                    buffers.distance[neighbor] = distance;
+                    buffers.parent[neighbor] = current.cell;
+                    openSet.push_back(
+                        {distance + heuristic(neighbor), order++, neighbor});
+                    std::push_heap(openSet.begin(), openSet.end());
+                    maxDist = distance;
                 }
             }
         }
@@ -121,105 +178,105 @@ findShortestPath(std::vector<std::vector<std::shared_ptr<square>>> vecBoard,
     return {};
 }
 
-std::vector<std::vector<std::shared_ptr<square>>>
-removeAboutTurn(std::vector<std::vector<std::shared_ptr<square>>> vecBoard,
-                dir _lastDir, size_t _xBoard, size_t _yBoard) {
-    // avoid going back with modifying the behind square in a copy of
-    // vecBoard
-    std::vector<std::vector<std::shared_ptr<square>>> vecBoardCopy(
-        vecBoard.size());
-    for (size_t i = 0; i < vecBoard.size(); i++) {
-        vecBoardCopy[i].resize(vecBoard[i].size());
-        for (size_t j = 0; j < vecBoard[i].size(); j++) {
-            vecBoardCopy[i][j] = std::make_shared<square>(*vecBoard[i][j]);
-        }
-    }
+BlockedSquares removeAboutTurn(gridView vecBoard, dir _lastDir,
+                               size_t _xBoard, size_t _yBoard) {
+    // avoid going back with blocking the behind square instead of modifying
+    // a copy of vecBoard
+    BlockedSquares blocked = {0, {}};
+    size_t x = _xBoard, y = _yBoard;
 
     switch (_lastDir) {
     case LEFT:
-        vecBoardCopy[_xBoard + 1][_yBoard]->setState(WALL);
+        x++;
         break;
     case RIGHT:
-        vecBoardCopy[_xBoard - 1][_yBoard]->setState(WALL);
+        x--;
         break;
     case UP:
-        vecBoardCopy[_xBoard][_yBoard + 1]->setState(WALL);
+        y++;
         break;
     case DOWN:
-        vecBoardCopy[_xBoard][_yBoard - 1]->setState(WALL);
+        y--;
         break;
     case NONE:
-        break;
+        return blocked;
     }
 
-    return vecBoardCopy;
-}
+    if (vecBoard.isInside(x, y))
+        blocked.squares[blocked.size++] = {int(x), int(y)};
 
-dir findDir(std::shared_ptr<Node> A, std::shared_ptr<Node> B) {
+    return blocked;
+}
 
-    if (A == nullptr || B == nullptr) {
-        std::cerr << "Empty node in findDir" << std::endl;
-        exit(EXIT_FAILURE);
-    }
+dir findDir(const Node &A, const Node &B) {
 
-    if (B->parent != A) {
-        std::cerr << "Nodes are not parent in findDir" << std::endl;
+    if (std::abs((int)A.x - (int)B.x) + std::abs((int)A.y - (int)B.y) != 1) {
+        std::cerr << "Nodes are not neighbors in findDir" << std::endl;
         exit(EXIT_FAILURE);
     }
 
-    if (A->x > B->x)
+    if (A.x > B.x)
         return LEFT;
 
-    else if (A->x < B->x)
+    else if (A.x < B.x)
         return RIGHT;
 
-    else if (A->y > B->y)
+    else if (A.y > B.y)
         return UP;
 
-    else if (A->y < B->y)
+    else if (A.y < B.y)
         return DOWN;
 
     else
         return NONE;
 }
 
-std::vector<dir>
-findPossibleDir(std::vector<std::vector<std::shared_ptr<square>>> vecBoard,
-                dir lastDir, dir avoidDir, size_t x, size_t y) {
+unsigned findPossibleDir(gridView vecBoard, dir lastDir, dir avoidDir,
+                         size_t x, size_t y) {
 
-    std::vector<dir> vecPossibleDir;
+    unsigned possibleDirs = 0;
+
+    // neighbors which are halls, read in the bitboard if the board has one
+    unsigned halls;
+    if (vecBoard.getPellets() != nullptr)
+        halls = vecBoard.getPellets()->getBits().getNeighbors(LAYER_HALL, x, y);
+    else
+        halls = (vecBoard.at(x - 1, y).getState() == HALL) * DIR_MASK(LEFT) |
+                (vecBoard.at(x + 1, y).getState() == HALL) * DIR_MASK(RIGHT) |
+                (vecBoard.at(x, y - 1).getState() == HALL) * DIR_MASK(UP) |
+                (vecBoard.at(x, y + 1).getState() == HALL) * DIR_MASK(DOWN);
 
     if (lastDir != RIGHT) {
 
         if (avoidDir != RIGHT) {
-            if (vecBoard[x - 1][y]->getState() == HALL)
-                vecPossibleDir.push_back(LEFT);
+            if (halls & DIR_MASK(LEFT))
+                possibleDirs |= DIR_MASK(LEFT);
         }
     }
 
     if (lastDir != LEFT) {
 
         if (avoidDir != RIGHT) {
-            if (vecBoard[x + 1][y]->getState() == HALL)
-                vecPossibleDir.push_back(RIGHT);
+            if (halls & DIR_MASK(RIGHT))
+                possibleDirs |= DIR_MASK(RIGHT);
         }
     }
 
     if (lastDir != DOWN) {
 
         if (avoidDir != UP) {
-            if (vecBoard[x][y - 1]->getState() == HALL)
-                vecPossibleDir.push_back(UP);
+            if (halls & DIR_MASK(UP))
+                possibleDirs |= DIR_MASK(UP);
         }
     }
 
     if (lastDir != UP) {
 
         if (avoidDir != DOWN) {
-            if (vecBoard[x][y + 1]->getState() == HALL)
-                vecPossibleDir.push_back(DOWN);
+            if (halls & DIR_MASK(DOWN))
+                possibleDirs |= DIR_MASK(DOWN);
         }
     }
 
-    return vecPossibleDir;
-}
\ No newline at end of file
+    return possibleDirs;
+}
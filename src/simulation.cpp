@@ -0,0 +1,244 @@
+#include "simulation.h"
+#include <cstring>
+
+simulation::simulation(uint64_t seed)
+    : _seed(seed), _levelHash(0), _rng(seed),
+      _pacman(_clock, _board.getLevel()),
+      _ghosts(_clock, _board.getLevel(), _rng),
+      _fruit(_clock, _board.getLevel()) {
+    _nbGhosts = NB_GHOSTS;
+    _level = 1;
+    _nextLevel = true;
+    _start = false;
+    _death = false;
+    _actorsChanged = true;
+    _currentDir = NONE;
+}
+
+simulation::~simulation() {}
+
+void simulation::load(const std::string &fileName,
+                      std::shared_ptr<const pathTable> paths) {
+    _board.load(fileName);
+    _board.loadPaths(paths);
+    _board.setItem();
+    _levelHash = _board.getLevel().getHash();
+}
+
+void simulation::newGame() {
+    _clock.reset();
+    _rng.setSeed(_seed);
+    _pacman.reset();
+    _level = 1;
+    _nextLevel = true;
+    _death = false;
+    _currentDir = NONE;
+}
+
+void simulation::startLife() {
+
+    // loose the life after the death animation
+    if (_death == true) {
+        _pacman.looseLife();
+        _death = false;
+    }
+
+    // initialize next level
+    if (_nextLevel == true) {
+        // reload all the items
+        _board.setItem();
+        _nextLevel = false;
+    }
+
+    // initialize pacman and ghost
+    _pacman.init();
+    _ghosts.reset(_nbGhosts);
+    _fruit = fruit(_clock, _board.getLevel());
+    _actorsChanged = true;
+
+    _start = false;
+}
+
+stepResult simulation::step(dir input) {
+
+    // press any key to start the game
+    if (input != NONE) {
+        _start = true;
+        _currentDir = input;
+    }
+    if (!_start)
+        return STEP_WAIT;
+
+    _clock.tick();
+    _actorsChanged = true;
+
+    // pacman movement management
+    if (_pacman.waitSquareCenter() == true)
+        _pacman.updateDir(_board.getBoard(), _currentDir);
+    _pacman.updatePos();
+    _pacman.updateSquare(_board.getBoard(), _ghosts, &_fruit);
+    // pacman eat fruit management
+    if (_fruit.updateFruit(_board.getBoard(), _pacman.getDotCounter(),
+                           _pacman.getFruitEaten()) == EXCEED) {
+        _pacman.resetDotCounter();
+    }
+
+    // ghost movement management
+    _ghosts.waitSquareCenter();
+    _ghosts.updateDir(_board.getBoard(), _pacman.getPos().first / SCALE_PIXEL,
+                      _pacman.getPos().second / SCALE_PIXEL,
+                      _pacman.getLastDir(), _level,
+                      _pacman.getDotCounterLevel(), _pacman.getRemainingLife(),
+                      _pacman.getNoEatenDotTimer());
+    _ghosts.updatePos();
+
+    // win statement, the remaining items are updated by pacman
+    if (_board.getDotList().empty() && _board.getPowerupList().empty()) {
+        // next level
+        _level++;
+        _nextLevel = true;
+        return STEP_LEVEL_CLEARED;
+    }
+
+    // loose statement
+    if (_pacman.ghostCollision(_ghosts)) {
+
+        // the life is lost at the beginning of the next one
+        _death = true;
+
+        // no more life
+        if (_pacman.getRemainingLife() <= 1)
+            return STEP_GAME_OVER;
+
+        return STEP_DEATH;
+    }
+
+    DEB(checkHash());
+    return STEP_PLAY;
+}
+
+bool simulation::isStarted() { return _start; }
+
+int simulation::getLevel() { return _level; }
+
+void simulation::setSeed(uint64_t seed) { _seed = seed; }
+
+void simulation::setNbGhosts(size_t nbGhosts) { _nbGhosts = nbGhosts; }
+
+size_t simulation::getNbGhosts() { return _nbGhosts; }
+
+uint64_t simulation::getSeed() { return _seed; }
+
+const gameClock &simulation::getClock() { return _clock; }
+
+board &simulation::getBoard() { return _board; }
+
+pacman &simulation::getPacman() { return _pacman; }
+
+ghostPack &simulation::getGhosts() { return _ghosts; }
+
+fruit &simulation::getFruit() { return _fruit; }
+
+const std::vector<Coordinate> &simulation::getDotList() {
+    return _board.getDotList();
+}
+
+const std::vector<Coordinate> &simulation::getPowerupList() {
+    return _board.getPowerupList();
+}
+
+const bitboard &simulation::getBits() {
+    if (_actorsChanged) {
+        _board.setActors(_pacman, _ghosts);
+        _actorsChanged = false;
+    }
+    return _board.getBits();
+}
+
+bool simulation::save(GameSnapshot &snapshot) {
+
+    if (_ghosts.size() > SNAPSHOT_MAX_GHOSTS)
+        return false;
+
+    snapshot.magic = SNAPSHOT_MAGIC;
+    snapshot.version = SNAPSHOT_VERSION;
+    snapshot.levelHash = _levelHash;
+    snapshot.tick = _clock.now();
+    snapshot.seed = _seed;
+    snapshot.rngState = _rng.getState();
+    snapshot.width = _board.getBoard().getWidth();
+    snapshot.height = _board.getBoard().getHeight();
+    snapshot.nbGhosts = _ghosts.size();
+    snapshot.level = _level;
+    snapshot.nextLevel = _nextLevel;
+    snapshot.start = _start;
+    snapshot.death = _death;
+    snapshot.currentDir = _currentDir;
+    memset(snapshot.padding, 0, sizeof(snapshot.padding));
+    if (!_pacman.save(snapshot.pacman))
+        return false;
+    _fruit.save(snapshot.fruit);
+    _ghosts.save(snapshot.ghosts);
+    memset(snapshot.ghosts + _ghosts.size(), 0,
+           (SNAPSHOT_MAX_GHOSTS - _ghosts.size()) * sizeof(GhostState));
+    if (!_board.savePellets(snapshot.dots, snapshot.powerups))
+        return false;
+    // the words after the last line are cleared for stable files
+    size_t rows = SNAPSHOT_MAX_ROWS - snapshot.height;
+    memset(snapshot.dots + snapshot.height, 0, rows * sizeof(uint64_t));
+    memset(snapshot.powerups + snapshot.height, 0, rows * sizeof(uint64_t));
+    return true;
+}
+
+bool simulation::restore(const GameSnapshot &snapshot) {
+
+    // the snapshot may not come from a file checked by readSnapshot
+    if (!checkSnapshot(snapshot) || snapshot.levelHash != _levelHash)
+        return false;
+
+    _clock.set(snapshot.tick);
+    _seed = snapshot.seed;
+    _rng.setState(snapshot.rngState);
+    _level = snapshot.level;
+    _nextLevel = snapshot.nextLevel;
+    _start = snapshot.start;
+    _death = snapshot.death;
+    _currentDir = dir(snapshot.currentDir);
+    _nbGhosts = snapshot.nbGhosts;
+    _pacman.restore(snapshot.pacman);
+    _ghosts.restore(snapshot.ghosts, snapshot.nbGhosts);
+    // the fruit square is set once the pellets are restored
+    _board.restorePellets(snapshot.dots, snapshot.powerups);
+    _fruit.restore(snapshot.fruit, _board.getBoard());
+    _actorsChanged = true;
+    return true;
+}
+
+uint64_t simulation::getGameHash() {
+    return zobristHasher(ZOBRIST_GAME)
+        .add(_clock.now())
+        .add(_rng.getState())
+        .add(_seed)
+        .add(_level)
+        .add(_nextLevel | _start << 1 | _death << 2 | _currentDir << 3)
+        .add(_nbGhosts)
+        .get();
+}
+
+uint64_t simulation::getHash() {
+    return _board.getHash() ^ _fruit.getHash() ^ _pacman.getHash() ^
+           _ghosts.getHash() ^ getGameHash();
+}
+
+uint64_t simulation::computeHash() {
+    return _board.computeHash() ^ _fruit.getHash() ^ _pacman.getHash() ^
+           _ghosts.getHash() ^ getGameHash();
+}
+
+void simulation::checkHash() {
+    if (getHash() != computeHash()) {
+        std::cerr << "The hash of the game differs from the board at tick "
+                  << _clock.now() << std::endl;
+        exit(EXIT_FAILURE);
+    }
+}
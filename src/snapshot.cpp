@@ -0,0 +1,34 @@
+#include "snapshot.h"
+#include <fstream>
+
+bool checkSnapshot(const GameSnapshot &snapshot) {
+    return snapshot.magic == SNAPSHOT_MAGIC &&
+           snapshot.version == SNAPSHOT_VERSION &&
+           snapshot.nbGhosts <= SNAPSHOT_MAX_GHOSTS &&
+           snapshot.height <= SNAPSHOT_MAX_ROWS &&
+           snapshot.pacman.nbEatenFruits <= SNAPSHOT_MAX_FRUITS;
+}
+
+bool writeSnapshot(const std::string &fileName, const GameSnapshot &snapshot) {
+
+    std::ofstream file(fileName, std::ios::binary);
+    if (!file.is_open())
+        return false;
+    file.write(reinterpret_cast<const char *>(&snapshot), sizeof(snapshot));
+    return bool(file);
+}
+
+bool readSnapshot(const std::string &fileName, GameSnapshot &snapshot) {
+
+    std::ifstream file(fileName, std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    GameSnapshot read;
+    if (!file.read(reinterpret_cast<char *>(&read), sizeof(read)) ||
+        !checkSnapshot(read))
+        return false;
+
+    snapshot = read;
+    return true;
+}
@@ -0,0 +1,368 @@
+#include "mcts.h"
+#include "player.h"
+#include "replay.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <thread>
+#include <unordered_set>
+
+#define DEFAULT_GAMES 100
+#define DEFAULT_MAX_TICKS 1000000 // about 3 hours of game
+
+struct Options {
+    size_t games;
+    size_t threads;
+    uint64_t seed;
+    tick_t maxTicks;
+    size_t ghosts;
+    policy player;
+    // search of the mcts player, on one thread by default as the games are
+    // played in parallel
+    MctsOptions mcts;
+    std::string level;
+    // directory where the games are recorded, empty to not record them
+    std::string record;
+    // replays played instead of new games
+    std::vector<std::string> replays;
+};
+
+static const char *playerNames[] = {"random", "greedy", "mcts"};
+
+struct GameResult {
+    size_t score;
+    int level;
+    int deaths;
+    tick_t ticks;
+    // hash of the game at its end
+    uint64_t hash;
+};
+
+/**
+ * @brief Read an integer in an option.
+ *
+ * @param option the name of the option
+ * @param value the text of the value
+ * @return uint64_t
+ */
+uint64_t readNumber(const char *option, const char *value) {
+
+    char *end = nullptr;
+    uint64_t number = strtoull(value, &end, 0);
+    if (end == value || *end != '\0') {
+        std::cerr << "Invalid " << option << ": " << value << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    return number;
+}
+
+/**
+ * @brief Read the options given on the command line.
+ *
+ * @param argc
+ * @param argv
+ * @return Options
+ */
+Options readOptions(int argc, char **argv) {
+
+    Options options = {DEFAULT_GAMES, std::thread::hardware_concurrency(),
+                       DEFAULT_SEED, DEFAULT_MAX_TICKS, NB_GHOSTS, GREEDY,
+                       {1, MCTS_DEFAULT_TIME, 0}, LEVEL_FILE, "", {}};
+
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--games=", 8) == 0)
+            options.games = readNumber("games", argv[i] + 8);
+        else if (strncmp(argv[i], "--threads=", 10) == 0)
+            options.threads = readNumber("threads", argv[i] + 10);
+        else if (strncmp(argv[i], "--seed=", 7) == 0)
+            options.seed = readNumber("seed", argv[i] + 7);
+        else if (strncmp(argv[i], "--max-ticks=", 12) == 0)
+            options.maxTicks = readNumber("max-ticks", argv[i] + 12);
+        else if (strncmp(argv[i], "--ghosts=", 9) == 0)
+            options.ghosts = readNumber("ghosts", argv[i] + 9);
+        else if (strncmp(argv[i], "--level=", 8) == 0)
+            options.level = argv[i] + 8;
+        else if (strncmp(argv[i], "--record=", 9) == 0)
+            options.record = argv[i] + 9;
+        else if (strncmp(argv[i], "--replay=", 9) == 0)
+            options.replays.push_back(argv[i] + 9);
+        else if (strcmp(argv[i], "--player=random") == 0)
+            options.player = RANDOM;
+        else if (strcmp(argv[i], "--player=greedy") == 0)
+            options.player = GREEDY;
+        else if (strcmp(argv[i], "--player=mcts") == 0)
+            options.player = MCTS;
+        else if (strncmp(argv[i], "--mcts-time=", 12) == 0)
+            options.mcts.time = readNumber("mcts-time", argv[i] + 12);
+        else if (strncmp(argv[i], "--mcts-threads=", 15) == 0)
+            options.mcts.threads = readNumber("mcts-threads", argv[i] + 15);
+        else if (strncmp(argv[i], "--mcts-iterations=", 18) == 0)
+            options.mcts.iterations =
+                readNumber("mcts-iterations", argv[i] + 18);
+        else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--games=N] [--threads=N] [--seed=N]"
+                         " [--max-ticks=N] [--ghosts=N] [--level=FILE]"
+                         " [--player=random|greedy|mcts] [--mcts-time=MS]"
+                         " [--mcts-threads=N] [--mcts-iterations=N]"
+                         " [--record=DIR] [--replay=FILE]..."
+                      << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    if (options.threads == 0)
+        options.threads = 1;
+
+    return options;
+}
+
+/**
+ * @brief Play a game until game over or until the maximum number of ticks.
+ *
+ * @param Sim
+ * @param options
+ * @param seed
+ * @param Replay where the game is recorded, nullptr to not record it
+ * @param Autopilot the search of the mcts player, nullptr for the others
+ * @return GameResult
+ */
+GameResult playGame(simulation &Sim, const Options &options, uint64_t seed,
+                    replay *Replay, mcts *Autopilot) {
+
+    GameResult result = {0, 1, 0, 0, 0};
+    // the player has its own sequence of random numbers
+    rng random(~seed);
+
+    Sim.setSeed(seed);
+    Sim.setNbGhosts(options.ghosts);
+    Sim.newGame();
+    Sim.startLife();
+    if (Replay != nullptr)
+        Replay->start(Sim, options.level);
+
+    while (Sim.getClock().now() < options.maxTicks) {
+
+        dir input = options.player == RANDOM   ? playRandom(Sim, random)
+                    : options.player == GREEDY ? playGreedy(Sim)
+                                               : Autopilot->play(Sim);
+        if (Replay != nullptr)
+            Replay->record(input, Sim);
+        stepResult step = Sim.step(input);
+
+        if (step == STEP_DEATH || step == STEP_GAME_OVER)
+            result.deaths++;
+        if (step == STEP_GAME_OVER)
+            break;
+        if (step == STEP_DEATH || step == STEP_LEVEL_CLEARED)
+            Sim.startLife();
+    }
+
+    result.score = Sim.getPacman().getScore();
+    result.level = Sim.getLevel();
+    result.ticks = Sim.getClock().now();
+    result.hash = Sim.getHash();
+    if (Replay != nullptr)
+        Replay->finish(Sim);
+    return result;
+}
+
+/**
+ * @brief Play the replays given on the command line in parallel and compare
+ * the end of each game with the recorded one.
+ *
+ * @param options
+ * @return int EXIT_SUCCESS if all the games end as they were recorded
+ */
+int playReplays(const Options &options) {
+
+    std::vector<replay> vecReplay(options.replays.size());
+    for (size_t i = 0; i < vecReplay.size(); i++) {
+        if (!vecReplay[i].load(options.replays[i])) {
+            std::cerr << "Unable to read the replay " << options.replays[i]
+                      << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    // the replays are played on the level of the first one
+    std::string levelName = vecReplay[0].getLevelName();
+    size_t nbThreads = std::min(options.threads, vecReplay.size());
+    std::vector<std::unique_ptr<simulation>> vecSim;
+    for (size_t i = 0; i < nbThreads; i++) {
+        vecSim.push_back(std::make_unique<simulation>());
+        vecSim.back()->load(levelName, vecSim[0]->getBoard().getPathTables());
+    }
+    uint64_t levelHash = vecSim[0]->getBoard().getLevel().getHash();
+
+    std::vector<ReplayResult> vecResult(vecReplay.size());
+    // replays of another level are not played, one byte per replay as the
+    // threads write the flags of different replays at the same time
+    std::vector<uint8_t> vecPlayed(vecReplay.size());
+    std::atomic<size_t> nextReplay(0);
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> vecThread;
+    for (size_t i = 0; i < nbThreads; i++) {
+        vecThread.emplace_back([&, i]() {
+            for (size_t game = nextReplay++; game < vecReplay.size();
+                 game = nextReplay++) {
+                vecPlayed[game] =
+                    vecReplay[game].getHeader().levelHash == levelHash;
+                if (vecPlayed[game])
+                    vecResult[game] = vecReplay[game].play(*vecSim[i]);
+            }
+        });
+    }
+    for (auto &thread : vecThread)
+        thread.join();
+
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    size_t nbMismatches = 0, nbSkipped = 0, nbOtherBuild = 0;
+    tick_t totalTicks = 0;
+    for (size_t i = 0; i < vecReplay.size(); i++) {
+        const ReplayHeader &header = vecReplay[i].getHeader();
+        if (vecReplay[i].getBuild() != replay::currentBuild())
+            nbOtherBuild++;
+        if (!vecPlayed[i]) {
+            std::cerr << options.replays[i] << ": not recorded on "
+                      << levelName << std::endl;
+            nbSkipped++;
+            continue;
+        }
+        totalTicks += vecResult[i].ticks;
+        if (vecResult[i].score != header.score ||
+            uint32_t(vecResult[i].level) != header.level ||
+            vecResult[i].divergence != REPLAY_NO_DIVERGENCE) {
+            std::cerr << options.replays[i] << ": score "
+                      << vecResult[i].score << " level "
+                      << vecResult[i].level << ", recorded score "
+                      << header.score << " level " << header.level;
+            if (vecResult[i].divergence != REPLAY_NO_DIVERGENCE)
+                std::cerr << ", diverged before the step "
+                          << vecResult[i].divergence;
+            std::cerr << std::endl;
+            nbMismatches++;
+        }
+    }
+
+    std::cout << "replays  " << vecReplay.size() << " (" << nbThreads
+              << " threads, " << nbOtherBuild
+              << " recorded by another build)" << std::endl;
+    std::cout << "results  " << vecReplay.size() - nbSkipped - nbMismatches
+              << " identical, " << nbMismatches << " different, "
+              << nbSkipped << " skipped" << std::endl;
+    std::cout << "ticks    " << totalTicks << std::endl;
+    std::cout << "time     " << elapsed.count() << "s ("
+              << totalTicks / elapsed.count() << " ticks/s)" << std::endl;
+
+    return nbMismatches == 0 && nbSkipped == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int main(int argc, char **argv) {
+
+    Options options = readOptions(argc, argv);
+    if (!options.replays.empty())
+        return playReplays(options);
+
+    // each thread plays its games on its own simulation, they share the
+    // path tables of the first one
+    size_t nbThreads = std::min(options.threads, std::max<size_t>(
+                                                     options.games, 1));
+    std::vector<std::unique_ptr<simulation>> vecSim;
+    for (size_t i = 0; i < nbThreads; i++) {
+        vecSim.push_back(std::make_unique<simulation>());
+        vecSim.back()->load(options.level,
+                            vecSim[0]->getBoard().getPathTables());
+    }
+    // the mcts player of each thread, with its own simulations
+    std::vector<std::unique_ptr<mcts>> vecAutopilot(nbThreads);
+    for (size_t i = 0; i < nbThreads && options.player == MCTS; i++)
+        vecAutopilot[i] = std::make_unique<mcts>(options.level, options.mcts);
+    if (options.player == GREEDY &&
+        vecSim[0]->getBoard().getBoard().getPaths() == nullptr) {
+        std::cerr << "The greedy player needs the path tables, which are not "
+                     "computed for this maze"
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::vector<GameResult> vecResult(options.games);
+    std::atomic<size_t> nextGame(0);
+    auto start = std::chrono::steady_clock::now();
+
+    // thread pool, each thread takes the next game to play
+    std::vector<std::thread> vecThread;
+    for (size_t i = 0; i < nbThreads; i++) {
+        vecThread.emplace_back([&, i]() {
+            replay Replay;
+            for (size_t game = nextGame++; game < options.games;
+                 game = nextGame++) {
+                uint64_t seed = options.seed + game;
+                if (options.record.empty()) {
+                    vecResult[game] = playGame(*vecSim[i], options, seed,
+                                               nullptr, vecAutopilot[i].get());
+                    continue;
+                }
+                vecResult[game] = playGame(*vecSim[i], options, seed, &Replay,
+                                           vecAutopilot[i].get());
+                std::string fileName =
+                    options.record + "/" + std::to_string(seed) + ".replay";
+                if (!Replay.save(fileName))
+                    std::cerr << "Unable to save the replay in " << fileName
+                              << std::endl;
+            }
+        });
+    }
+    for (auto &thread : vecThread)
+        thread.join();
+
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    // summary
+    size_t totalScore = 0, maxScore = 0, minScore = SIZE_MAX;
+    int totalLevel = 0, maxLevel = 0, totalDeaths = 0;
+    tick_t totalTicks = 0;
+    // hash of all the games in their order, to compare two runs, and the
+    // number of different ends
+    uint64_t runHash = 0;
+    std::unordered_set<uint64_t> setHash;
+    for (auto &result : vecResult) {
+        runHash = zobristMix(runHash ^ result.hash) + ZOBRIST_SEED;
+        setHash.insert(result.hash);
+        totalScore += result.score;
+        maxScore = std::max(maxScore, result.score);
+        minScore = std::min(minScore, result.score);
+        totalLevel += result.level;
+        maxLevel = std::max(maxLevel, result.level);
+        totalDeaths += result.deaths;
+        totalTicks += result.ticks;
+    }
+    double nbGames = std::max<double>(options.games, 1);
+
+    std::cout << "games    " << options.games << " (seeds " << options.seed
+              << " to " << options.seed + options.games - 1 << ", "
+              << nbThreads << " threads, " << options.ghosts << " ghosts, "
+              << playerNames[options.player] << " player)" << std::endl;
+    if (options.games == 0)
+        return EXIT_SUCCESS;
+    std::cout << "score    mean " << totalScore / nbGames << " min "
+              << minScore << " max " << maxScore << std::endl;
+    std::cout << "level    mean " << totalLevel / nbGames << " max "
+              << maxLevel << std::endl;
+    std::cout << "deaths   " << totalDeaths << std::endl;
+    std::cout << "ticks    " << totalTicks << " (mean "
+              << totalTicks / nbGames << ")" << std::endl;
+    std::cout << "hash     " << std::hex << std::setw(16)
+              << std::setfill('0') << runHash << std::dec << " ("
+              << setHash.size() << " different ends)" << std::endl;
+    std::cout << "time     " << elapsed.count() << "s ("
+              << totalTicks / elapsed.count() << " ticks/s)" << std::endl;
+
+    return EXIT_SUCCESS;
+}
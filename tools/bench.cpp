@@ -0,0 +1,489 @@
+#include "pacman_env.h"
+#include "player.h"
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <new>
+
+#ifndef BENCH_NO_SDL
+#include "display.h"
+#endif
+
+#define BENCH_MIN_TIME 0.2       // each benchmark runs at least 0.2s
+#define BENCH_RECORD_TICKS 20000 // ticks played to record the game states
+#define BENCH_SEED 1
+#define BENCH_ENVS 16           // games of the environment benchmark
+#define BENCH_ENV_CHECK 20000   // steps checked to not allocate
+#define BENCH_ENV_ACTION 16     // steps with the same random action
+
+#ifndef BENCH_COMMIT
+#define BENCH_COMMIT "unknown"
+#endif
+
+// number of allocations since the beginning of the program, the benchmarks
+// run on one thread
+static size_t allocCount = 0;
+
+void *operator new(size_t size) {
+    allocCount++;
+    if (void *p = malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void *operator new[](size_t size) { return operator new(size); }
+
+void operator delete(void *p) noexcept { free(p); }
+
+void operator delete[](void *p) noexcept { free(p); }
+
+void operator delete(void *p, size_t) noexcept { free(p); }
+
+void operator delete[](void *p, size_t) noexcept { free(p); }
+
+struct BenchResult {
+    std::string name;
+    uint64_t ops;
+    double nsPerOp;
+    double allocsPerOp;
+};
+
+struct Options {
+    bool json;
+    std::string filter;
+    double minTime;
+    std::string level;
+};
+
+/**
+ * @brief State of the ghosts before a call to ghost::updateDir for one of
+ * them with the arguments given by the simulation.
+ */
+struct GhostSample {
+    ghostPack Ghosts;
+    size_t id;
+    size_t xPac, yPac;
+    dir dirPac;
+    int level, dotCounter, life;
+    tick_t noEatenDotTimer;
+};
+
+/**
+ * @brief Run an operation until BENCH_MIN_TIME is spent, doubling the number
+ * of operations at each round.
+ *
+ * @param name
+ * @param options
+ * @param op the operation, called with the index of the operation
+ * @param vecResult the result is added to it
+ */
+void runBench(const std::string &name, const Options &options,
+              const std::function<void(size_t)> &op,
+              std::vector<BenchResult> &vecResult) {
+
+    if (name.find(options.filter) == std::string::npos)
+        return;
+
+    // warm up the caches and the buffers
+    for (size_t i = 0; i < 16; i++)
+        op(i);
+
+    uint64_t ops = 1;
+    for (;;) {
+        size_t allocStart = allocCount;
+        auto start = std::chrono::steady_clock::now();
+        for (uint64_t i = 0; i < ops; i++)
+            op(i);
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        size_t allocs = allocCount - allocStart;
+
+        if (elapsed.count() >= options.minTime) {
+            vecResult.push_back({name, ops, elapsed.count() * 1e9 / ops,
+                                 double(allocs) / ops});
+            if (!options.json)
+                printf("%-36s %12.1f ns/op %8.2f allocs/op %14.0f op/s\n",
+                       name.c_str(), vecResult.back().nsPerOp,
+                       vecResult.back().allocsPerOp,
+                       1e9 / vecResult.back().nsPerOp);
+            return;
+        }
+        ops *= 2;
+    }
+}
+
+/**
+ * @brief Read the options given on the command line.
+ *
+ * @param argc
+ * @param argv
+ * @return Options
+ */
+Options readOptions(int argc, char **argv) {
+
+    Options options = {false, "", BENCH_MIN_TIME, LEVEL_FILE};
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0)
+            options.json = true;
+        else if (strncmp(argv[i], "--filter=", 9) == 0)
+            options.filter = argv[i] + 9;
+        else if (strncmp(argv[i], "--time=", 7) == 0)
+            options.minTime = atof(argv[i] + 7);
+        else if (strncmp(argv[i], "--level=", 8) == 0)
+            options.level = argv[i] + 8;
+        else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--json] [--filter=NAME] [--time=SECONDS]"
+                         " [--level=FILE]"
+                      << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    return options;
+}
+
+/**
+ * @brief Name of a ghost mode for the benchmark names.
+ *
+ * @param Ghost
+ * @return const char*
+ */
+const char *modeName(ghost &Ghost) {
+    if (Ghost.isReturnHouse())
+        return "return";
+    switch (Ghost.getMode()) {
+    case CHASE:
+        return "chase";
+    case SCATTER:
+        return "scatter";
+    case FRIGHTENED:
+        return "frightened";
+    case ANY:
+        break;
+    }
+    return "any";
+}
+
+int main(int argc, char **argv) {
+
+    Options options = readOptions(argc, argv);
+    std::vector<BenchResult> vecResult;
+
+    // board with all its items
+    board Board;
+    Board.load(options.level);
+    Board.loadPaths();
+    Board.setItem();
+    gridView view = Board.getBoard();
+
+    std::vector<Coordinate> vecCell;
+    for (size_t y = 0; y < view.getHeight(); y++) {
+        for (size_t x = 0; x < view.getWidth(); x++) {
+            if (view.at(x, y).getState() != WALL)
+                vecCell.push_back({int(x), int(y)});
+        }
+    }
+    size_t nbCells = vecCell.size();
+
+    // record the states of a game played by the greedy player
+    simulation Sim(BENCH_SEED);
+    Sim.load(options.level);
+    Sim.newGame();
+    Sim.startLife();
+    bool hasPaths = Sim.getBoard().getBoard().getPaths() != nullptr;
+    rng recordRandom(BENCH_SEED);
+    std::vector<pacman> vecPacman;
+    std::vector<std::vector<GhostSample>> vecGhostSample(NB_COLORS * 5);
+    std::vector<std::string> vecGhostName(NB_COLORS * 5);
+    const char *colorName[NB_COLORS] = {"red", "pink", "blue", "orange"};
+    for (size_t tick = 0; tick < BENCH_RECORD_TICKS; tick++) {
+
+        pacman &Pacman = Sim.getPacman();
+        vecPacman.push_back(Pacman);
+        // waitSquareCenter moves the ghosts to the center of the squares, the
+        // game must not be changed
+        ghostPack Sample = Sim.getGhosts();
+        Sample.waitSquareCenter();
+        for (size_t i = 0; i < Sample.size(); i++) {
+            ghost &Ghost = Sample[i];
+            if (!Sample.isAtCenter(i) || Ghost.isInHouse())
+                continue;
+            size_t category =
+                Ghost.getGhost() * 5 +
+                (Ghost.isReturnHouse() ? 4 : size_t(Ghost.getMode()));
+            vecGhostName[category] = std::string("ghost::updateDir/") +
+                                     colorName[Ghost.getGhost()] + "/" +
+                                     modeName(Ghost);
+            vecGhostSample[category].push_back(
+                {Sample, i, Pacman.getPos().first / SCALE_PIXEL,
+                 Pacman.getPos().second / SCALE_PIXEL, Pacman.getLastDir(),
+                 Sim.getLevel(), int(Pacman.getDotCounterLevel()),
+                 Pacman.getRemainingLife(), Pacman.getNoEatenDotTimer()});
+        }
+
+        // the greedy player needs the path tables, which large mazes do not
+        // have
+        dir input =
+            hasPaths ? playGreedy(Sim) : playRandom(Sim, recordRandom);
+        stepResult result = Sim.step(input);
+        if (result == STEP_GAME_OVER)
+            Sim.newGame();
+        if (result != STEP_PLAY && result != STEP_WAIT)
+            Sim.startLife();
+    }
+
+    // path finding
+    runBench("findShortestPath/all_pairs", options,
+             [&](size_t i) {
+                 Coordinate start = vecCell[i % nbCells];
+                 Coordinate end = vecCell[(i / nbCells) % nbCells];
+                 findShortestPath(view, start.x, start.y, end.x, end.y);
+             },
+             vecResult);
+    if (hasPaths)
+        runBench("pathTable::getNextDir/all_pairs", options,
+                 [&](size_t i) {
+                     Coordinate start = vecCell[i % nbCells];
+                     Coordinate end = vecCell[(i / nbCells) % nbCells];
+                     view.getPaths()->getNextDir(start.x, start.y, end.x,
+                                                 end.y, dir(i % 4));
+                 },
+                 vecResult);
+    runBench("findPossibleDir", options,
+             [&](size_t i) {
+                 Coordinate cell = vecCell[i % nbCells];
+                 findPossibleDir(view, dir(i % 5), NONE, cell.x, cell.y);
+             },
+             vecResult);
+    runBench("removeAboutTurn", options,
+             [&](size_t i) {
+                 Coordinate cell = vecCell[i % nbCells];
+                 removeAboutTurn(view, dir(i % 5), cell.x, cell.y);
+             },
+             vecResult);
+
+    // items
+    runBench("board::getDotList", options,
+             [&](size_t) { Board.getDotList(); }, vecResult);
+    runBench("board::getPowerupList", options,
+             [&](size_t) { Board.getPowerupList(); }, vecResult);
+
+    // bitboard
+    const bitboard &bits = Board.getBits();
+    runBench("bitboard::count", options,
+             [&](size_t i) { bits.count(layer(LAYER_DOT + i % 2)); },
+             vecResult);
+    runBench("bitboard::countInRadius", options,
+             [&](size_t i) {
+                 Coordinate cell = vecCell[i % nbCells];
+                 bits.countInRadius(LAYER_DOT, cell.x, cell.y, i % 8);
+             },
+             vecResult);
+    runBench("bitboard::getLegalMoves", options,
+             [&](size_t i) {
+                 Coordinate cell = vecCell[i % nbCells];
+                 bits.getLegalMoves(cell.x, cell.y, dir(i % 5));
+             },
+             vecResult);
+
+    // ghosts
+    for (size_t category = 0; category < vecGhostSample.size(); category++) {
+        std::vector<GhostSample> &vecSample = vecGhostSample[category];
+        if (vecSample.empty())
+            continue;
+        ghostPack Ghosts = vecSample[0].Ghosts;
+        runBench(vecGhostName[category], options,
+                 [&](size_t i) {
+                     GhostSample &sample = vecSample[i % vecSample.size()];
+                     Ghosts = sample.Ghosts;
+                     Ghosts.updateDir(sample.id, view, sample.xPac,
+                                      sample.yPac, sample.dirPac, sample.level,
+                                      sample.dotCounter, sample.life,
+                                      sample.noEatenDotTimer);
+                 },
+                 vecResult);
+    }
+    {
+        ghostPack Ghosts = Sim.getGhosts();
+        runBench("ghostPack::waitSquareCenter", options,
+                 [&](size_t) { Ghosts.waitSquareCenter(); }, vecResult);
+        runBench("ghostPack::updatePos", options,
+                 [&](size_t) { Ghosts.updatePos(); }, vecResult);
+        runBench("ghostPack::findContact", options,
+                 [&](size_t i) {
+                     pacman &Pacman = vecPacman[i % vecPacman.size()];
+                     Ghosts.findContact(Pacman.getPos().first,
+                                        Pacman.getPos().second,
+                                        GHOST_PACMAN_CONTACT);
+                 },
+                 vecResult);
+    }
+
+    // pacman, the eaten items are put back after each call
+    {
+        ghostPack Ghosts = Sim.getGhosts();
+        fruit Fruit(Sim.getClock(), Sim.getBoard().getLevel());
+        pacman Pacman = vecPacman[0];
+        runBench("pacman::updateSquare", options,
+                 [&](size_t i) {
+                     Pacman = vecPacman[i % vecPacman.size()];
+                     size_t x = Pacman.getPos().first / SCALE_PIXEL;
+                     size_t y = Pacman.getPos().second / SCALE_PIXEL;
+                     square saved = view.at(x, y);
+                     Pacman.updateSquare(view, Ghosts, &Fruit);
+                     view.at(x, y) = saved;
+                     view.getPellets()->add(x, y, typeItem(saved.getItem()));
+                 },
+                 vecResult);
+    }
+
+    // whole game
+    {
+        simulation Game(BENCH_SEED);
+        Game.load(options.level);
+        Game.newGame();
+        Game.startLife();
+        rng random(BENCH_SEED);
+        runBench("simulation::step", options,
+                 [&](size_t) {
+                     stepResult result = Game.step(playRandom(Game, random));
+                     if (result == STEP_GAME_OVER)
+                         Game.newGame();
+                     if (result != STEP_PLAY && result != STEP_WAIT)
+                         Game.startLife();
+                 },
+                 vecResult);
+        runBench("simulation::getHash", options,
+                 [&](size_t) { Game.getHash(); }, vecResult);
+
+        // snapshots, the restore goes back and forth between two states
+        // which differ by a few eaten dots
+        GameSnapshot snapshots[2];
+        if (Game.save(snapshots[0])) {
+            for (int i = 0; i < 100; i++) {
+                stepResult result = Game.step(playRandom(Game, random));
+                if (result != STEP_PLAY && result != STEP_WAIT)
+                    Game.startLife();
+            }
+            Game.save(snapshots[1]);
+            runBench("simulation::save", options,
+                     [&](size_t i) { Game.save(snapshots[i % 2]); },
+                     vecResult);
+            runBench("simulation::restore", options,
+                     [&](size_t i) { Game.restore(snapshots[i % 2]); },
+                     vecResult);
+        }
+    }
+
+    // environment on the calling thread, each game keeps a random action
+    // for a few steps so that pacman eats the powerups; the steps are
+    // checked first to not allocate, frightened ghosts included
+    if (std::string("pacman_env_step").find(options.filter) !=
+        std::string::npos) {
+        pacman_env *env = pacman_env_create_level(options.level.c_str(),
+                                                  BENCH_ENVS, BENCH_SEED, 1);
+        if (env == nullptr) {
+            std::cerr << "Unable to create the environment" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        size_t planes, height, width;
+        pacman_env_obs_shape(env, &planes, &height, &width);
+        size_t cells = height * width;
+        std::vector<uint8_t> obs(BENCH_ENVS * planes * cells);
+        std::vector<int32_t> actions(BENCH_ENVS, PACMAN_ENV_NOOP);
+        std::vector<float> rewards(BENCH_ENVS);
+        std::vector<uint8_t> dones(BENCH_ENVS);
+        rng random(BENCH_SEED);
+        auto step = [&](size_t i) {
+            if (i % BENCH_ENV_ACTION == 0) {
+                for (auto &action : actions)
+                    action = random.bounded(PACMAN_ENV_NOOP + 1);
+            }
+            pacman_env_step(env, actions.data(), obs.data(), rewards.data(),
+                            dones.data());
+        };
+        pacman_env_reset(env, obs.data());
+
+        size_t allocStart = allocCount, frightened = 0;
+        for (size_t i = 0; i < BENCH_ENV_CHECK; i++) {
+            step(i);
+            for (size_t game = 0; game < BENCH_ENVS; game++) {
+                const uint8_t *ghosts = &obs[(game * planes +
+                                              PACMAN_ENV_PLANE_GHOSTS) *
+                                             cells];
+                frightened += std::count(ghosts,
+                                         ghosts + (planes -
+                                                   PACMAN_ENV_PLANE_GHOSTS) *
+                                                      cells,
+                                         PACMAN_ENV_GHOST_FRIGHTENED);
+            }
+        }
+        if (allocCount != allocStart || frightened == 0) {
+            std::cerr << "pacman_env_step: " << allocCount - allocStart
+                      << " allocations, " << frightened
+                      << " frightened ghosts seen" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        runBench("pacman_env_step", options, step, vecResult);
+        pacman_env_destroy(env);
+    }
+
+#ifndef BENCH_NO_SDL
+    // display in a surface which is not shown
+    {
+        SDL_Surface *windowSurf = SDL_CreateRGBSurfaceWithFormat(
+            0, 676, 900 + SCORE_HEADER, 32, SDL_PIXELFORMAT_ARGB8888);
+        SDL_Surface *spriteBoard = SDL_LoadBMP("assets/pacman_sprites.bmp");
+        if (windowSurf == nullptr || spriteBoard == nullptr) {
+            std::cerr << "Unable to create the surfaces: " << SDL_GetError()
+                      << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        // the surface backend and the software renderer
+        const std::pair<const char *, backend> backends[] = {
+            {"display::show/surface", BACKEND_SURFACE},
+            {"display::show/software", BACKEND_SOFTWARE}};
+        DrawList list;
+        for (auto &Backend : backends) {
+            display Display;
+            if (!Display.open(windowSurf, spriteBoard, Backend.second)) {
+                std::cerr << "Unable to open the display: " << SDL_GetError()
+                          << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            int count = 0;
+            runBench(Backend.first, options,
+                     [&](size_t) {
+                         count = buildFrame(
+                             list, count, Sim.getPacman(), Sim.getGhosts(),
+                             Sim.getDotList(), Sim.getPowerupList(),
+                             Sim.getFruit().getFruit(),
+                             Sim.getPacman().getScore(), 0, PACMAN_LIVE, true,
+                             Sim.getLevel(), Sim.getClock());
+                         Display.show(list);
+                     },
+                     vecResult);
+            Display.close();
+        }
+        SDL_FreeSurface(spriteBoard);
+        SDL_FreeSurface(windowSurf);
+    }
+#endif
+
+    if (options.json) {
+        printf("{\n  \"commit\": \"%s\",\n  \"benchmarks\": [\n", BENCH_COMMIT);
+        for (size_t i = 0; i < vecResult.size(); i++) {
+            BenchResult &result = vecResult[i];
+            printf("    {\"name\": \"%s\", \"ops\": %lu, \"ns_per_op\": %.2f, "
+                   "\"allocs_per_op\": %.3f, \"ops_per_s\": %.0f}%s\n",
+                   result.name.c_str(), (unsigned long)result.ops,
+                   result.nsPerOp, result.allocsPerOp, 1e9 / result.nsPerOp,
+                   i + 1 < vecResult.size() ? "," : "");
+        }
+        printf("  ]\n}\n");
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,43 @@
+#include "level.h"
+#include <cstring>
+
+/**
+ * @brief Compile a level, optionally repeated horizontally to make a larger
+ * maze.
+ *
+ * @param argc
+ * @param argv
+ * @return int
+ */
+int main(int argc, char **argv) {
+
+    size_t nbTiles = 1;
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--tiles=", 8) == 0)
+            nbTiles = strtoull(argv[i] + 8, nullptr, 0);
+        else
+            files.push_back(argv[i]);
+    }
+    if (files.size() != 2 || nbTiles == 0) {
+        std::cerr << "Usage: " << argv[0] << " [--tiles=N] INPUT OUTPUT"
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    level Level;
+    if (!Level.load(files[0])) {
+        std::cerr << "Unable to load " << files[0] << std::endl;
+        return EXIT_FAILURE;
+    }
+    Level.tile(nbTiles);
+    if (!Level.save(files[1])) {
+        std::cerr << "Unable to save " << files[1] << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << files[1] << ": " << Level.getWidth() << "x"
+              << Level.getHeight() << ", " << Level.getPowerups().size()
+              << " powerups" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,67 @@
+#include "player.h"
+#include <algorithm>
+
+dir playRandom(simulation &Sim, rng &random) {
+
+    if (Sim.getClock().now() % RANDOM_TURN_TICKS != 0 && Sim.isStarted())
+        return NONE;
+    return dir(random.bounded(4));
+}
+
+dir playGreedy(simulation &Sim) {
+
+    const pathTable *paths = Sim.getBoard().getBoard().getPaths();
+    size_t xPac = Sim.getPacman().getPos().first / SCALE_PIXEL;
+    size_t yPac = Sim.getPacman().getPos().second / SCALE_PIXEL;
+
+    // distance to the nearest dangerous ghost from a square
+    auto ghostDistance = [&](size_t x, size_t y) {
+        int nearest = UNREACHABLE;
+        for (auto &Ghost : Sim.getGhosts()) {
+            if (Ghost.isFrightened() || Ghost.isReturnHouse())
+                continue;
+            int distance =
+                paths->getDistance(x, y, Ghost.getPos().first / SCALE_PIXEL,
+                                   Ghost.getPos().second / SCALE_PIXEL);
+            if (distance != -1)
+                nearest = std::min(nearest, distance);
+        }
+        return nearest;
+    };
+
+    // run away, take the neighbor the farthest from the ghosts
+    if (ghostDistance(xPac, yPac) <= GHOST_DANGER) {
+        dir best = NONE;
+        int bestDistance = -1;
+        for (dir d : {LEFT, RIGHT, UP, DOWN}) {
+            int x = xPac + (d == RIGHT) - (d == LEFT);
+            int y = yPac + (d == DOWN) - (d == UP);
+            if (paths->getDistance(xPac, yPac, x, y) != 1)
+                continue;
+            int distance = ghostDistance(x, y);
+            if (distance > bestDistance) {
+                bestDistance = distance;
+                best = d;
+            }
+        }
+        if (best != NONE)
+            return best;
+    }
+
+    // go to the nearest item
+    int bestDistance = UNREACHABLE;
+    Coordinate target = {int(xPac), int(yPac)};
+    for (auto *vecItem : {&Sim.getDotList(), &Sim.getPowerupList()}) {
+        for (auto &coord : *vecItem) {
+            int distance = paths->getDistance(xPac, yPac, coord.x, coord.y);
+            if (distance != -1 && distance < bestDistance) {
+                bestDistance = distance;
+                target = coord;
+            }
+        }
+    }
+    dir next = paths->getNextDir(xPac, yPac, target.x, target.y);
+
+    // the game only starts when a direction is pressed
+    return next == NONE && !Sim.isStarted() ? LEFT : next;
+}
@@ -0,0 +1,29 @@
+#ifndef PLAYER_H
+#define PLAYER_H
+
+#include "simulation.h"
+
+#define RANDOM_TURN_TICKS 50 // the random player turns every 0.5s
+#define GHOST_DANGER 3       // the greedy player runs away from the ghosts
+                             // closer than 3 squares
+
+enum policy { RANDOM, GREEDY, MCTS };
+
+/**
+ * @brief Random player, keep a random direction during RANDOM_TURN_TICKS.
+ *
+ * @param Sim
+ * @param random
+ * @return dir
+ */
+dir playRandom(simulation &Sim, rng &random);
+/**
+ * @brief Greedy player, go to the nearest dot or powerup and run away from
+ * the ghosts which are too close.
+ *
+ * @param Sim
+ * @return dir
+ */
+dir playGreedy(simulation &Sim);
+
+#endif